@@ -0,0 +1,110 @@
+/**
+ * @file benchmark.h
+ * @brief Minimal timing helpers shared by the Chapter 1 benchmark programs.
+ * @details Provides a wall-clock timer and a function that repeats a callable until enough time has elapsed to give a stable per-call latency, and the memory use of the process.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+/**
+ * @brief Prevents the compiler from discarding a value that is computed only for timing.
+ *
+ * @tparam T The type of the value.
+ * @param value The value that must be materialized in memory.
+ */
+template <typename T>
+inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "m"(value) : "memory");
+}
+
+/**
+ * @brief A wall-clock stopwatch that starts on construction.
+ */
+class Stopwatch {
+public:
+    /**
+     * @brief Constructs a Stopwatch and starts it.
+     */
+    Stopwatch() : _start(std::chrono::steady_clock::now()) {}
+
+    /**
+     * @brief Restarts the stopwatch.
+     */
+    void reset() {
+        _start = std::chrono::steady_clock::now();
+    }
+
+    /**
+     * @brief Returns the time elapsed since construction or the last reset.
+     *
+     * @return double The elapsed time in seconds.
+     */
+    double seconds() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point _start;
+};
+
+/**
+ * @brief Measures the average latency of a callable.
+ * @details The callable is run in batches of doubling size until at least min_seconds have elapsed, so cheap calls are not dominated by clock overhead.
+ *
+ * @tparam F The type of the callable.
+ * @param f The callable to be timed.
+ * @param min_seconds The minimum total time to spend measuring.
+ * @return double The average time of one call in seconds.
+ */
+template <typename F>
+double seconds_per_call(F&& f, double min_seconds = 0.05) {
+    std::uint64_t iterations = 1;
+    while (true) {
+        Stopwatch watch;
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            f();
+        }
+        double elapsed = watch.seconds();
+        if (elapsed >= min_seconds) {
+            return elapsed / iterations;
+        }
+        iterations *= 2;
+    }
+}
+
+/**
+ * @brief Returns a memory figure of this process from /proc/self/status.
+ *
+ * @param field The name of the field, e.g. "VmRSS" for the resident set or "VmHWM" for its peak.
+ * @return std::uint64_t The value in bytes, or 0 if it is not available on this system.
+ */
+inline std::uint64_t process_memory_bytes(const std::string& field) {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, field.size(), field) == 0 && line.size() > field.size() && line[field.size()] == ':')
+            return std::stoull(line.substr(field.size() + 1)) * 1024;  // reported in kB
+    }
+    return 0;
+}
+
+#endif // BENCHMARK_H
@@ -0,0 +1,728 @@
+/**
+ * @file big_unsigned.h
+ * @brief An arbitrary-precision unsigned integer with fast multiplication.
+ * @details BigUnsigned stores its magnitude as little-endian 32-bit limbs in either base 2^32 (BinaryRadix) or
+ * base 10^8 (DecimalRadix). Multiplication switches from the schoolbook method to Karatsuba and then to a
+ * number-theoretic transform (NTT) over two primes as the operands grow, and the transforms of large products
+ * run on separate threads. Numbers are written to a stream through a fixed-size buffer, so printing a
+ * multi-megabyte value never builds it as one std::string; binary values are converted to decimal by a
+ * divide-and-conquer method that only needs multiplications. Division is built on Newton's iteration for the
+ * reciprocal, so it also runs at the speed of multiplication.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BIG_UNSIGNED_H
+#define BIG_UNSIGNED_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Limbs in base 2^32; the NTT splits every limb into two 16-bit digits.
+ */
+struct BinaryRadix {
+    static constexpr std::uint64_t base = std::uint64_t(1) << 32;
+    static constexpr std::uint32_t ntt_digit_base = std::uint32_t(1) << 16;
+};
+
+/**
+ * @brief Limbs in base 10^8; the NTT splits every limb into two 4-digit decimal digits.
+ */
+struct DecimalRadix {
+    static constexpr std::uint64_t base = 100000000;
+    static constexpr std::uint32_t ntt_digit_base = 10000;
+};
+
+/**
+ * @brief A number-theoretic transform modulo a prime of the form c * 2^k + 1.
+ *
+ * @tparam Mod The prime modulus.
+ * @tparam Root A primitive root of Mod.
+ */
+template <std::uint32_t Mod, std::uint32_t Root>
+class Ntt {
+public:
+    static constexpr std::uint32_t mod = Mod;
+
+    /**
+     * @brief Returns the largest power of two transform length supported by Mod.
+     *
+     * @return std::size_t The maximum transform length.
+     */
+    static constexpr std::size_t max_length() {
+        return std::size_t(1) << std::countr_zero(Mod - 1);
+    }
+
+    /**
+     * @brief Computes base^exponent modulo Mod.
+     *
+     * @param base The base.
+     * @param exponent The exponent.
+     * @return std::uint32_t The modular power.
+     */
+    static constexpr std::uint32_t power(std::uint32_t base, std::uint64_t exponent) {
+        std::uint64_t result = 1;
+        std::uint64_t b = base;
+        while (exponent != 0) {
+            if (exponent & 1)
+                result = result * b % Mod;
+            b = b * b % Mod;
+            exponent >>= 1;
+        }
+        return static_cast<std::uint32_t>(result);
+    }
+
+    /**
+     * @brief Transforms values in place; the length must be a power of two no larger than max_length().
+     *
+     * @param values The values to be transformed, each less than Mod.
+     * @param inverse True for the inverse transform, which also divides by the length.
+     */
+    static void transform(std::vector<std::uint32_t>& values, bool inverse) {
+        const std::size_t n = values.size();
+        for (std::size_t i = 1, j = 0; i < n; ++i) {  // bit-reversal permutation
+            std::size_t bit = n >> 1;
+            for (; j & bit; bit >>= 1)
+                j ^= bit;
+            j ^= bit;
+            if (i < j)
+                std::swap(values[i], values[j]);
+        }
+
+        // roots[half + k] = w^k for the stage that combines blocks of length 2 * half; shoup[i] = roots[i] * 2^32 / Mod.
+        std::vector<std::uint32_t> roots(std::max<std::size_t>(n, 2)), shoup(roots.size());
+        for (std::size_t half = 1; half < n; half <<= 1) {
+            std::uint32_t step = power(Root, (Mod - 1) / (2 * half));
+            if (inverse)
+                step = power(step, Mod - 2);
+            roots[half] = 1;
+            for (std::size_t k = 1; k < half; ++k)
+                roots[half + k] = static_cast<std::uint32_t>(std::uint64_t(roots[half + k - 1]) * step % Mod);
+        }
+        for (std::size_t i = 1; i < n; ++i)
+            shoup[i] = static_cast<std::uint32_t>((std::uint64_t(roots[i]) << 32) / Mod);
+
+        for (std::size_t half = 1; half < n; half <<= 1) {
+            const std::uint32_t* w = roots.data() + half;
+            const std::uint32_t* w_shoup = shoup.data() + half;
+            for (std::size_t start = 0; start < n; start += 2 * half) {
+                std::uint32_t* low = values.data() + start;
+                std::uint32_t* high = low + half;
+                for (std::size_t k = 0; k < half; ++k) {
+                    std::uint32_t u = low[k];
+                    std::uint32_t v = _multiply_shoup(high[k], w[k], w_shoup[k]);
+                    low[k] = u + v >= Mod ? u + v - Mod : u + v;
+                    high[k] = u >= v ? u - v : u + Mod - v;
+                }
+            }
+        }
+
+        if (inverse) {
+            std::uint64_t n_inverse = power(static_cast<std::uint32_t>(n % Mod), Mod - 2);
+            for (std::uint32_t& value : values)
+                value = static_cast<std::uint32_t>(value * n_inverse % Mod);
+        }
+    }
+
+private:
+    static_assert(Mod < (std::uint32_t(1) << 31), "Shoup multiplication needs 2 * Mod below 2^32");
+
+    /**
+     * @brief Returns x * w modulo Mod using the precomputed quotient w_shoup = floor(w * 2^32 / Mod).
+     * @details The estimated quotient is off by at most one, so a single conditional subtraction suffices and no
+     * 64-bit division is executed.
+     */
+    static std::uint32_t _multiply_shoup(std::uint32_t x, std::uint32_t w, std::uint32_t w_shoup) {
+        std::uint32_t q = static_cast<std::uint32_t>((std::uint64_t(x) * w_shoup) >> 32);
+        std::uint32_t r = x * w - q * Mod;
+        return r >= Mod ? r - Mod : r;
+    }
+};
+
+/**
+ * @brief An arbitrary-precision unsigned integer.
+ *
+ * @tparam Radix BinaryRadix or DecimalRadix, which selects the base of the limbs.
+ */
+template <typename Radix>
+class BigUnsigned {
+public:
+    using limb_type = std::uint32_t;
+
+    /**
+     * @brief Operands with fewer limbs than this are multiplied with the schoolbook method.
+     */
+    static constexpr std::size_t karatsuba_threshold = 32;
+
+    /**
+     * @brief Products with at least this many limbs are computed with the NTT.
+     */
+    static constexpr std::size_t ntt_threshold = 3000;
+
+    /**
+     * @brief Products with at least this many limbs run their transforms on separate threads.
+     */
+    static constexpr std::size_t parallel_threshold = 1 << 15;
+
+    /**
+     * @brief Constructs a BigUnsigned from a machine integer.
+     *
+     * @param value The initial value.
+     */
+    BigUnsigned(std::uint64_t value = 0) {
+        while (value != 0) {
+            _limbs.push_back(static_cast<limb_type>(value % Radix::base));
+            value /= Radix::base;
+        }
+    }
+
+    /**
+     * @brief Constructs a BigUnsigned from little-endian limbs, each of which must be less than the base.
+     *
+     * @param limbs The limbs, least significant first.
+     * @return BigUnsigned The constructed value.
+     */
+    static BigUnsigned from_limbs(std::vector<limb_type> limbs) {
+        BigUnsigned result;
+        result._limbs = std::move(limbs);
+        result._trim();
+        return result;
+    }
+
+    /**
+     * @brief Returns the limbs, least significant first, without leading zero limbs.
+     *
+     * @return const std::vector<limb_type>& The limbs.
+     */
+    const std::vector<limb_type>& limbs() const {
+        return _limbs;
+    }
+
+    /**
+     * @brief Returns whether the value is zero.
+     *
+     * @return bool True if the value is zero.
+     */
+    bool is_zero() const {
+        return _limbs.empty();
+    }
+
+    /**
+     * @brief Three-way comparison of two values.
+     */
+    friend std::strong_ordering operator<=>(const BigUnsigned& lhs, const BigUnsigned& rhs) {
+        if (lhs._limbs.size() != rhs._limbs.size())
+            return lhs._limbs.size() <=> rhs._limbs.size();
+        for (std::size_t i = lhs._limbs.size(); i-- > 0;) {
+            if (lhs._limbs[i] != rhs._limbs[i])
+                return lhs._limbs[i] <=> rhs._limbs[i];
+        }
+        return std::strong_ordering::equal;
+    }
+
+    /**
+     * @brief Equality of two values.
+     */
+    friend bool operator==(const BigUnsigned& lhs, const BigUnsigned& rhs) = default;
+
+    /**
+     * @brief Adds another value to this one.
+     *
+     * @param other The value to be added.
+     * @return BigUnsigned& This value.
+     */
+    BigUnsigned& operator+=(const BigUnsigned& other) {
+        _add_shifted(_limbs, other._limbs.data(), other._limbs.size(), 0);
+        return *this;
+    }
+
+    /**
+     * @brief Subtracts another value from this one.
+     *
+     * @param other The value to be subtracted.
+     * @return BigUnsigned& This value.
+     * @throws std::underflow_error If other is greater than this value.
+     */
+    BigUnsigned& operator-=(const BigUnsigned& other) {
+        if (*this < other)
+            throw std::underflow_error("BigUnsigned subtraction would be negative");
+        _subtract(_limbs, other._limbs.data(), other._limbs.size());
+        _trim();
+        return *this;
+    }
+
+    /**
+     * @brief Multiplies this value by another one.
+     *
+     * @param other The multiplier.
+     * @return BigUnsigned& This value.
+     */
+    BigUnsigned& operator*=(const BigUnsigned& other) {
+        *this = *this * other;
+        return *this;
+    }
+
+    friend BigUnsigned operator+(BigUnsigned lhs, const BigUnsigned& rhs) {
+        lhs += rhs;
+        return lhs;
+    }
+
+    friend BigUnsigned operator-(BigUnsigned lhs, const BigUnsigned& rhs) {
+        lhs -= rhs;
+        return lhs;
+    }
+
+    /**
+     * @brief Multiplies two values, choosing the algorithm from the operand sizes.
+     */
+    friend BigUnsigned operator*(const BigUnsigned& lhs, const BigUnsigned& rhs) {
+        if (lhs.is_zero() || rhs.is_zero())
+            return BigUnsigned();
+        return from_limbs(_multiply(lhs._limbs.data(), lhs._limbs.size(), rhs._limbs.data(), rhs._limbs.size()));
+    }
+
+    /**
+     * @brief Returns the value multiplied by base^count.
+     *
+     * @param count The number of limbs to shift by.
+     * @return BigUnsigned The shifted value.
+     */
+    BigUnsigned shifted_left(std::size_t count) const {
+        BigUnsigned result;
+        if (!is_zero()) {
+            result._limbs.assign(count, 0);
+            result._limbs.insert(result._limbs.end(), _limbs.begin(), _limbs.end());
+        }
+        return result;
+    }
+
+    /**
+     * @brief Returns the value divided by base^count, rounded down.
+     *
+     * @param count The number of limbs to shift by.
+     * @return BigUnsigned The shifted value.
+     */
+    BigUnsigned shifted_right(std::size_t count) const {
+        BigUnsigned result;
+        if (count < _limbs.size())
+            result._limbs.assign(_limbs.begin() + count, _limbs.end());
+        return result;
+    }
+
+    /**
+     * @brief Divides this value by a single limb in place.
+     *
+     * @param divisor The divisor.
+     * @return limb_type The remainder.
+     * @throws std::domain_error If the divisor is zero.
+     */
+    limb_type divide_by(limb_type divisor) {
+        if (divisor == 0)
+            throw std::domain_error("BigUnsigned division by zero");
+        std::uint64_t remainder = 0;
+        for (std::size_t i = _limbs.size(); i-- > 0;) {
+            std::uint64_t current = remainder * Radix::base + _limbs[i];
+            _limbs[i] = static_cast<limb_type>(current / divisor);
+            remainder = current % divisor;
+        }
+        _trim();
+        return static_cast<limb_type>(remainder);
+    }
+
+    /**
+     * @brief Writes the value in its native base: hexadecimal for BinaryRadix, decimal for DecimalRadix.
+     * @details Digits go through a fixed-size buffer, so no string of the full value is ever built.
+     *
+     * @param out The output stream.
+     */
+    void write(std::ostream& out) const {
+        constexpr bool binary = Radix::base == BinaryRadix::base;
+        constexpr int digits_per_limb = 8;  // 8 hex digits in base 2^32, 8 decimal digits in base 10^8
+        constexpr limb_type digit_base = binary ? 16 : 10;
+
+        if (is_zero()) {
+            out << '0';
+            return;
+        }
+
+        std::array<char, 1 << 16> buffer;
+        std::size_t used = 0;
+        auto emit = [&](limb_type limb, bool pad) {
+            char digits[digits_per_limb];
+            int count = 0;
+            do {
+                limb_type digit = limb % digit_base;
+                digits[count++] = static_cast<char>(digit < 10 ? '0' + digit : 'a' + digit - 10);
+                limb /= digit_base;
+            } while (limb != 0);
+            if (pad) {
+                while (count < digits_per_limb)
+                    digits[count++] = '0';
+            }
+            if (used + count > buffer.size()) {
+                out.write(buffer.data(), used);
+                used = 0;
+            }
+            while (count > 0)
+                buffer[used++] = digits[--count];
+        };
+
+        emit(_limbs.back(), false);
+        for (std::size_t i = _limbs.size() - 1; i-- > 0;)
+            emit(_limbs[i], true);
+        out.write(buffer.data(), used);
+    }
+
+private:
+    /**
+     * @brief Removes leading zero limbs so that zero has no limbs.
+     */
+    void _trim() {
+        while (!_limbs.empty() && _limbs.back() == 0)
+            _limbs.pop_back();
+    }
+
+    /**
+     * @brief Adds b * base^shift to the limbs of a in place, growing a as needed.
+     */
+    static void _add_shifted(std::vector<limb_type>& a, const limb_type* b, std::size_t nb, std::size_t shift) {
+        if (a.size() < shift + nb)
+            a.resize(shift + nb, 0);
+        std::uint64_t carry = 0;
+        std::size_t i = 0;
+        for (; i < nb; ++i) {
+            std::uint64_t sum = std::uint64_t(a[shift + i]) + b[i] + carry;
+            a[shift + i] = static_cast<limb_type>(sum % Radix::base);
+            carry = sum / Radix::base;
+        }
+        for (std::size_t j = shift + i; carry != 0; ++j) {
+            if (j == a.size())
+                a.push_back(0);
+            std::uint64_t sum = std::uint64_t(a[j]) + carry;
+            a[j] = static_cast<limb_type>(sum % Radix::base);
+            carry = sum / Radix::base;
+        }
+    }
+
+    /**
+     * @brief Subtracts b from the limbs of a in place; a must not be smaller than b.
+     */
+    static void _subtract(std::vector<limb_type>& a, const limb_type* b, std::size_t nb) {
+        std::int64_t borrow = 0;
+        for (std::size_t i = 0; i < a.size() && (i < nb || borrow != 0); ++i) {
+            std::int64_t difference = std::int64_t(a[i]) - (i < nb ? b[i] : 0) - borrow;
+            borrow = difference < 0;
+            a[i] = static_cast<limb_type>(difference + (borrow ? std::int64_t(Radix::base) : 0));
+        }
+    }
+
+    /**
+     * @brief Multiplies two limb sequences and returns the (untrimmed) product limbs.
+     */
+    static std::vector<limb_type> _multiply(const limb_type* a, std::size_t na, const limb_type* b, std::size_t nb) {
+        if (na < nb) {
+            std::swap(a, b);
+            std::swap(na, nb);
+        }
+        if (nb < karatsuba_threshold)
+            return _multiply_schoolbook(a, na, b, nb);
+        if (na + nb >= ntt_threshold)
+            return _multiply_ntt(a, na, b, nb);
+        return _multiply_karatsuba(a, na, b, nb);
+    }
+
+    /**
+     * @brief Multiplies two limb sequences in O(na * nb).
+     */
+    static std::vector<limb_type> _multiply_schoolbook(const limb_type* a, std::size_t na, const limb_type* b, std::size_t nb) {
+        std::vector<limb_type> result(na + nb, 0);
+        for (std::size_t j = 0; j < nb; ++j) {
+            std::uint64_t carry = 0;
+            for (std::size_t i = 0; i < na; ++i) {
+                std::uint64_t t = result[i + j] + std::uint64_t(a[i]) * b[j] + carry;  // at most base^2 - 1
+                result[i + j] = static_cast<limb_type>(t % Radix::base);
+                carry = t / Radix::base;
+            }
+            result[na + j] = static_cast<limb_type>(carry);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Multiplies two limb sequences with Karatsuba's method; na must not be smaller than nb.
+     */
+    static std::vector<limb_type> _multiply_karatsuba(const limb_type* a, std::size_t na, const limb_type* b, std::size_t nb) {
+        const std::size_t m = na / 2;
+        std::vector<limb_type> result;
+        if (nb <= m) {  // unbalanced: split only a
+            result = _multiply(a, m, b, nb);
+            std::vector<limb_type> high = _multiply(a + m, na - m, b, nb);
+            _add_shifted(result, high.data(), high.size(), m);
+            result.resize(na + nb);
+            return result;
+        }
+
+        std::vector<limb_type> a_sum(a, a + m), b_sum(b, b + m);
+        _add_shifted(a_sum, a + m, na - m, 0);
+        _add_shifted(b_sum, b + m, nb - m, 0);
+
+        std::vector<limb_type> low = _multiply(a, m, b, m);
+        std::vector<limb_type> high = _multiply(a + m, na - m, b + m, nb - m);
+        std::vector<limb_type> middle = _multiply(a_sum.data(), a_sum.size(), b_sum.data(), b_sum.size());
+        _subtract(middle, low.data(), low.size());
+        _subtract(middle, high.data(), high.size());
+
+        result = low;
+        _add_shifted(result, middle.data(), middle.size(), m);
+        _add_shifted(result, high.data(), high.size(), 2 * m);
+        result.resize(na + nb);
+        return result;
+    }
+
+    using NttA = Ntt<998244353, 3>;
+    using NttB = Ntt<469762049, 3>;
+
+    /**
+     * @brief Multiplies two limb sequences with an NTT over two primes combined by the Chinese remainder theorem.
+     * @details Every limb is split into two digits below Radix::ntt_digit_base, so a convolution term is below
+     * length * 2^32 <= 2^55, which the product of the two primes (about 2^58.7) represents exactly.
+     */
+    static std::vector<limb_type> _multiply_ntt(const limb_type* a, std::size_t na, const limb_type* b, std::size_t nb) {
+        constexpr std::uint32_t digit_base = Radix::ntt_digit_base;
+        const std::size_t digits = 2 * (na + nb);
+        const std::size_t length = std::bit_ceil(digits);
+        if (length > std::min(NttA::max_length(), NttB::max_length()))
+            throw std::length_error("BigUnsigned product is too large for the NTT");
+
+        auto split = [&](const limb_type* limbs, std::size_t n) {
+            std::vector<std::uint32_t> result(length, 0);
+            for (std::size_t i = 0; i < n; ++i) {
+                result[2 * i] = limbs[i] % digit_base;
+                result[2 * i + 1] = limbs[i] / digit_base;
+            }
+            return result;
+        };
+        const bool square = a == b && na == nb;
+        const bool parallel = na + nb >= parallel_threshold && std::thread::hardware_concurrency() > 1;
+
+        // Each prime yields the convolution modulo that prime; the two pipelines are independent.
+        auto convolve = [&]<typename N>(N) {
+            std::vector<std::uint32_t> fa = split(a, na);
+            if (square) {
+                N::transform(fa, false);
+                for (std::uint32_t& x : fa)
+                    x = static_cast<std::uint32_t>(std::uint64_t(x) * x % N::mod);
+            } else {
+                std::vector<std::uint32_t> fb = split(b, nb);
+                std::future<void> pending;
+                if (parallel)
+                    pending = std::async(std::launch::async, [&fb] { N::transform(fb, false); });
+                N::transform(fa, false);
+                if (parallel)
+                    pending.get();
+                else
+                    N::transform(fb, false);
+                for (std::size_t i = 0; i < length; ++i)
+                    fa[i] = static_cast<std::uint32_t>(std::uint64_t(fa[i]) * fb[i] % N::mod);
+            }
+            N::transform(fa, true);
+            return fa;
+        };
+
+        std::vector<std::uint32_t> residues_a, residues_b;
+        if (parallel) {
+            auto pending = std::async(std::launch::async, [&] { return convolve(NttB()); });
+            residues_a = convolve(NttA());
+            residues_b = pending.get();
+        } else {
+            residues_a = convolve(NttA());
+            residues_b = convolve(NttB());
+        }
+
+        constexpr std::uint64_t inverse_a = NttB::power(NttA::mod % NttB::mod, NttB::mod - 2);
+        std::vector<limb_type> result(na + nb, 0);
+        std::uint64_t carry = 0;
+        std::uint32_t low_digit = 0;
+        for (std::size_t i = 0; i < digits; ++i) {
+            std::uint64_t ra = residues_a[i], rb = residues_b[i];
+            std::uint64_t t = (rb + NttB::mod - ra % NttB::mod) % NttB::mod * inverse_a % NttB::mod;
+            carry += ra + t * NttA::mod;
+            std::uint32_t digit = static_cast<std::uint32_t>(carry % digit_base);
+            carry /= digit_base;
+            if (i % 2 == 0)
+                low_digit = digit;
+            else
+                result[i / 2] = low_digit + digit * digit_base;
+        }
+        return result;
+    }
+
+    std::vector<limb_type> _limbs;  // little endian, no leading zero limbs
+};
+
+/**
+ * @brief Approximates base^(2n) / b for an n-limb b whose top limb is at least base / 2.
+ * @details Starting from the quotient of the top limb, every step of Newton's iteration
+ * x += x (base^(2p) - c x) / base^(2p), where c holds the top p limbs of b, nearly doubles the number of correct
+ * limbs; one limb per step is kept as a guard so the rounding errors do not accumulate. The total cost is a small
+ * multiple of one n-limb product, and the result is within a few units of the exact quotient.
+ *
+ * @param b The normalized divisor.
+ * @return BigUnsigned<Radix> The approximate reciprocal.
+ */
+template <typename Radix>
+BigUnsigned<Radix> normalized_reciprocal(const BigUnsigned<Radix>& b) {
+    using Big = BigUnsigned<Radix>;
+    const std::size_t n = b.limbs().size();
+    const unsigned __int128 base = Radix::base;
+    Big x(static_cast<std::uint64_t>(base * base / b.limbs().back()));
+
+    for (std::size_t p = 1; p < n;) {
+        std::size_t next = std::min(n, p == 1 ? 2 : 2 * p - 1);
+        Big c = b.shifted_right(n - next);
+        Big one = Big(1).shifted_left(2 * next);
+        x = x.shifted_left(next - p);
+        Big product = c * x;
+        if (product <= one)
+            x += (x * (one - product)).shifted_right(2 * next);
+        else
+            x -= (x * (product - one)).shifted_right(2 * next);
+        p = next;
+    }
+    return x;
+}
+
+/**
+ * @brief Divides two values, rounding down.
+ * @details Both operands are scaled so that the top limb of the divisor is at least base / 2, the quotient is
+ * taken from a Newton reciprocal and then corrected by the remainder.
+ *
+ * @param a The dividend.
+ * @param b The divisor.
+ * @return BigUnsigned<Radix> The quotient.
+ * @throws std::domain_error If the divisor is zero.
+ */
+template <typename Radix>
+BigUnsigned<Radix> divide(const BigUnsigned<Radix>& a, const BigUnsigned<Radix>& b) {
+    using Big = BigUnsigned<Radix>;
+    if (b.is_zero())
+        throw std::domain_error("BigUnsigned division by zero");
+    if (a < b)
+        return Big();
+
+    Big factor(Radix::base / (std::uint64_t(b.limbs().back()) + 1));
+    Big dividend = a * factor;
+    Big divisor = b * factor;
+    std::size_t n = divisor.limbs().size();
+    if (dividend.limbs().size() > 2 * n) {
+        std::size_t extra = dividend.limbs().size() - 2 * n;
+        dividend = dividend.shifted_left(extra);
+        divisor = divisor.shifted_left(extra);
+        n += extra;
+    }
+
+    Big quotient = (dividend * normalized_reciprocal(divisor)).shifted_right(2 * n);
+    Big product = quotient * divisor;
+    while (product > dividend) {
+        quotient -= Big(1);
+        product -= divisor;
+    }
+    Big remainder = dividend - product;
+    while (remainder >= divisor) {
+        quotient += Big(1);
+        remainder -= divisor;
+    }
+    return quotient;
+}
+
+/**
+ * @brief Converts a binary value to base 10^8 limbs.
+ * @details The limbs are split in half recursively and recombined as high * 2^(32m) + low, where the decimal
+ * powers 2^(32 * 2^k) are computed once by repeated squaring. Only additions and fast multiplications are used,
+ * so the conversion costs O(M(n) log n) for an n-limb value.
+ *
+ * @param value The value to be converted.
+ * @return BigUnsigned<DecimalRadix> The same value in base 10^8.
+ */
+inline BigUnsigned<DecimalRadix> to_decimal(const BigUnsigned<BinaryRadix>& value) {
+    using Decimal = BigUnsigned<DecimalRadix>;
+    constexpr std::size_t schoolbook_limbs = 32;
+    const std::vector<std::uint32_t>& limbs = value.limbs();
+
+    std::vector<Decimal> powers{Decimal(BinaryRadix::base)};  // powers[k] = 2^(32 * 2^k)
+    while ((std::size_t(1) << powers.size()) < limbs.size())
+        powers.push_back(powers.back() * powers.back());
+
+    auto convert = [&](auto& self, std::size_t begin, std::size_t end) -> Decimal {
+        if (end - begin <= schoolbook_limbs) {
+            Decimal result;
+            for (std::size_t i = end; i-- > begin;)
+                result = result * powers[0] + Decimal(limbs[i]);
+            return result;
+        }
+        int k = std::bit_width(end - begin - 1) - 1;  // largest 2^k below the length
+        std::size_t middle = begin + (std::size_t(1) << k);
+        return self(self, middle, end) * powers[k] + self(self, begin, middle);
+    };
+    return convert(convert, 0, limbs.size());
+}
+
+/**
+ * @brief Writes a value in hexadecimal without building a string of the whole value.
+ *
+ * @param out The output stream.
+ * @param value The value to be written.
+ */
+inline void write_hex(std::ostream& out, const BigUnsigned<BinaryRadix>& value) {
+    value.write(out);
+}
+
+/**
+ * @brief Writes a value in decimal without building a string of the whole value.
+ *
+ * @param out The output stream.
+ * @param value The value to be written.
+ */
+inline void write_decimal(std::ostream& out, const BigUnsigned<BinaryRadix>& value) {
+    to_decimal(value).write(out);
+}
+
+/**
+ * @brief Writes a value in decimal.
+ */
+inline std::ostream& operator<<(std::ostream& out, const BigUnsigned<BinaryRadix>& value) {
+    write_decimal(out, value);
+    return out;
+}
+
+/**
+ * @brief Writes a value in decimal.
+ */
+inline std::ostream& operator<<(std::ostream& out, const BigUnsigned<DecimalRadix>& value) {
+    value.write(out);
+    return out;
+}
+
+#endif // BIG_UNSIGNED_H
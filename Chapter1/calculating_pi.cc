@@ -20,27 +20,9 @@
 #include <cstdlib>
 #include <iostream>
 
-using namespace std;
-
-/**
- * Calculates the value of pi using the Leibniz formula.
- * @param n_terms The number of terms to use in the calculation.
- * @return The calculated value of pi.
- */
-float calculate_pi(int n_terms) {
-    float numerator = 4.0;
-    float denominator = 1.0;
-    float operation = 1.0;
-    float pi = 0.0;
-
-    for (int i = 0; i < n_terms; ++i) {
-        pi += operation * (numerator / denominator);
-        denominator += 2.0;
-        operation *= -1.0;
-    }
+#include "calculating_pi.h"
 
-    return pi;
-}
+using namespace std;
 
 /**
  * The main function that calls the calculate_pi function to calculate the value of pi with 1,000,000 terms and prints it to the console.
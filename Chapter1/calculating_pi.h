@@ -0,0 +1,48 @@
+/**
+ * @file calculating_pi.h
+ * @brief A function that calculates the value of pi using the Leibniz formula.
+ * @details The Leibniz formula sums the series 4/1 - 4/3 + 4/5 - 4/7 + ..., which converges to pi.
+ * @copyright Copyright 2023 Kyungwon Chun
+ * 
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#ifndef CALCULATING_PI_H
+#define CALCULATING_PI_H
+
+#include <cstdint>
+
+/**
+ * Calculates the value of pi using the Leibniz formula.
+ * @tparam T The numeric type of the calculation, float by default. It must be constructible from double and
+ * support +=, *=, * and /.
+ * @param n_terms The number of terms to use in the calculation.
+ * @return The calculated value of pi.
+ */
+template <typename T = float>
+T calculate_pi(std::uint64_t n_terms) {
+    T numerator = 4.0;
+    T denominator = 1.0;
+    T operation = 1.0;
+    T pi = 0.0;
+
+    for (std::uint64_t i = 0; i < n_terms; ++i) {
+        pi += operation * (numerator / denominator);
+        denominator += 2.0;
+        operation *= -1.0;
+    }
+
+    return pi;
+}
+
+#endif // CALCULATING_PI_H
@@ -0,0 +1,139 @@
+/**
+ * @file concurrent_memo.cc
+ * @brief A program that calculates Fibonacci numbers with a memo shared between threads.
+ * @details This program evaluates the fib3 recurrence through a ConcurrentMemo, both exactly and modulo a prime for an index far beyond what the recursive fib3 could reach without overflowing the stack. It then runs a stress benchmark in which a growing number of threads look up random indices of one shared memo, checks every answer against a sequentially computed reference, and prints the lookup throughput.
+ * @copyright Copyright 2023 Kyungwon Chun
+ * 
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "benchmark.h"
+#include "concurrent_memo.h"
+#include "fib_fast.h"
+
+constexpr std::uint64_t prime = 1000000007;
+
+/**
+ * @brief The fib3 recurrence modulo a prime, as a step function for ConcurrentMemo.
+ * 
+ * @param n The index to be computed.
+ * @param memo The memo holding every smaller index.
+ * @return std::uint64_t fib(n) mod prime.
+ */
+std::uint64_t fib_mod_step(std::size_t n, const ConcurrentMemo<std::uint64_t>& memo) {
+    if (n < 2)  // base case
+        return n;
+    return (memo.at(n - 1) + memo.at(n - 2)) % prime;  // recursive case, read from the memo
+}
+
+/**
+ * Calculates the nth Fibonacci number with a memo that can be shared by any number of threads.
+ * 
+ * @param n The index of the Fibonacci number to be calculated.
+ * @return std::uint64_t The nth Fibonacci number.
+ * @throws std::overflow_error If F(n) does not fit in 64 bits.
+ */
+std::uint64_t fib_memo(std::size_t n) {
+    static ConcurrentMemo<std::uint64_t> memo;
+    if (n > max_fib_index<std::uint64_t>())
+        throw std::overflow_error("fib(" + std::to_string(n) + ") does not fit in the result type");
+    return memo.get(n, [](std::size_t i, const ConcurrentMemo<std::uint64_t>& m) -> std::uint64_t {
+        return i < 2 ? i : m.at(i - 1) + m.at(i - 2);
+    });
+}
+
+/**
+ * @brief A xorshift generator that gives every benchmark thread its own cheap stream of indices.
+ */
+struct XorShift {
+    std::uint64_t state;
+
+    std::uint64_t operator()() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+/**
+ * @brief The main function that runs the examples and the multi-threaded stress benchmark.
+ * 
+ * @param argc The number of command-line arguments provided.
+ * @param argv An array of strings containing the command-line arguments.
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    std::cout << "fib(5) = " << fib_memo(5) << std::endl;
+    std::cout << "fib(93) = " << fib_memo(93) << std::endl;
+
+    constexpr std::size_t table_size = 1 << 22;
+    ConcurrentMemo<std::uint64_t> big_memo;
+    std::cout << "fib(" << table_size - 1 << ") mod " << prime << " = "
+              << big_memo.get(table_size - 1, fib_mod_step) << std::endl;
+
+    std::vector<std::uint64_t> reference(table_size);
+    reference[1] = 1;
+    for (std::size_t i = 2; i < table_size; ++i)
+        reference[i] = (reference[i - 1] + reference[i - 2]) % prime;
+
+    constexpr std::size_t lookups_per_thread = 1 << 22;
+    const unsigned max_threads = std::max(8u, 2 * std::thread::hardware_concurrency());
+    std::cout << std::setw(8) << "threads" << std::setw(18) << "cold Mlookups/s" << std::setw(18) << "warm Mlookups/s" << std::endl;
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        ConcurrentMemo<std::uint64_t> memo;
+        std::atomic<std::size_t> mismatches{0};
+
+        auto run = [&](std::uint64_t seed) {
+            std::vector<std::thread> workers;
+            Stopwatch watch;
+            for (unsigned t = 0; t < threads; ++t) {
+                workers.emplace_back([&, t] {
+                    XorShift random{seed * 0x9e3779b97f4a7c15ULL + t + 1};
+                    std::size_t local_mismatches = 0;
+                    for (std::size_t k = 0; k < lookups_per_thread; ++k) {
+                        std::size_t index = random() % table_size;
+                        local_mismatches += memo.get(index, fib_mod_step) != reference[index];
+                    }
+                    mismatches += local_mismatches;
+                });
+            }
+            for (std::thread& worker : workers)
+                worker.join();
+            return double(threads) * lookups_per_thread / watch.seconds() / 1e6;
+        };
+
+        double cold = run(1);  // the memo starts empty and is filled by whichever threads get there first
+        double warm = run(2);
+        std::cout << std::setw(8) << threads << std::fixed << std::setprecision(1) << std::setw(18) << cold
+                  << std::setw(18) << warm << std::endl;
+        if (mismatches != 0) {
+            std::cerr << mismatches << " lookups returned a wrong value" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,188 @@
+/**
+ * @file concurrent_memo.h
+ * @brief A thread-safe memoization cache for functions of a non-negative integer.
+ * @details ConcurrentMemo stores results in a flat, index-addressed array made of segments that double in size.
+ * A segment is never moved once it is published, so a reference to a cached value stays valid and readers
+ * never take a lock: every slot carries an atomic state that is set with release semantics after the value has
+ * been written. Missing values are filled bottom-up in index order instead of by recursion, so recurrences such
+ * as the one in fib3 can be evaluated for large n without overflowing the stack.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CONCURRENT_MEMO_H
+#define CONCURRENT_MEMO_H
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+/**
+ * @brief A lock-free, growable cache of values indexed by a non-negative integer.
+ *
+ * @tparam T The type of the cached values; it must be default constructible and assignable.
+ */
+template <typename T>
+class ConcurrentMemo {
+public:
+    ConcurrentMemo() {
+        for (auto& segment : _segments)
+            segment.store(nullptr, std::memory_order_relaxed);
+    }
+
+    ConcurrentMemo(const ConcurrentMemo&) = delete;
+    ConcurrentMemo& operator=(const ConcurrentMemo&) = delete;
+
+    ~ConcurrentMemo() {
+        for (auto& segment : _segments)
+            delete[] segment.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns the cached value at an index without blocking.
+     *
+     * @param index The index of the value.
+     * @return const T* A pointer to the value, or nullptr if it has not been published yet.
+     */
+    const T* find(std::size_t index) const {
+        const Slot* slot = _slot_if_allocated(index);
+        if (slot == nullptr || slot->state.load(std::memory_order_acquire) != ready)
+            return nullptr;
+        return &slot->value;
+    }
+
+    /**
+     * @brief Returns the value at an index that has already been claimed, waiting while it is being written.
+     * @details This is meant for the step function passed to get(), whose lower indices are always either
+     * published or in the middle of being published by another thread.
+     *
+     * @param index The index of the value.
+     * @return const T& The value.
+     */
+    const T& at(std::size_t index) const {
+        const Slot& slot = *_slot_if_allocated(index);
+        while (slot.state.load(std::memory_order_acquire) != ready)
+            std::this_thread::yield();
+        return slot.value;
+    }
+
+    /**
+     * @brief Publishes a value unless another thread has already claimed the same index.
+     *
+     * @param index The index of the value.
+     * @param value The value to be cached.
+     * @return bool True if this call stored the value.
+     */
+    bool publish(std::size_t index, const T& value) {
+        Slot& slot = _slot(index);
+        std::uint8_t expected = empty;
+        if (!slot.state.compare_exchange_strong(expected, writing, std::memory_order_acquire))
+            return false;
+        slot.value = value;
+        slot.state.store(ready, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Returns the value at an index, computing every missing value up to it in increasing index order.
+     * @details step(i, memo) must compute the value at i and may read any smaller index through memo.at().
+     *
+     * @tparam Step The type of the step function.
+     * @param index The index of the value.
+     * @param step The function that computes one value from the smaller ones.
+     * @return const T& The value.
+     */
+    template <typename Step>
+    const T& get(std::size_t index, Step&& step) {
+        if (const T* value = find(index))
+            return *value;
+
+        std::size_t filled = _filled.load(std::memory_order_acquire);
+        for (std::size_t i = filled; i <= index; ++i) {
+            const Slot& slot = _slot(i);
+            if (slot.state.load(std::memory_order_acquire) == empty)
+                publish(i, step(i, *this));
+        }
+
+        while (filled <= index && find(filled) != nullptr)
+            ++filled;
+        std::size_t current = _filled.load(std::memory_order_relaxed);
+        while (current < filled && !_filled.compare_exchange_weak(current, filled, std::memory_order_release)) {
+        }
+        return at(index);
+    }
+
+    /**
+     * @brief Returns the length of the prefix of indices known to be published.
+     *
+     * @return std::size_t The number of leading published indices.
+     */
+    std::size_t filled() const {
+        return _filled.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr std::uint8_t empty = 0;
+    static constexpr std::uint8_t writing = 1;
+    static constexpr std::uint8_t ready = 2;
+
+    static constexpr int first_segment_bits = 6;  // the first segment holds 64 values
+    static constexpr int max_segments = 64 - first_segment_bits;
+
+    struct Slot {
+        std::atomic<std::uint8_t> state{empty};
+        T value{};
+    };
+
+    /**
+     * @brief Maps an index to its segment and the offset within that segment.
+     */
+    static std::pair<int, std::size_t> _locate(std::size_t index) {
+        std::size_t biased = index + (std::size_t(1) << first_segment_bits);
+        int segment = std::bit_width(biased) - 1 - first_segment_bits;
+        return {segment, biased - (std::size_t(1) << (segment + first_segment_bits))};
+    }
+
+    const Slot* _slot_if_allocated(std::size_t index) const {
+        auto [segment, offset] = _locate(index);
+        const Slot* slots = _segments[segment].load(std::memory_order_acquire);
+        return slots == nullptr ? nullptr : slots + offset;
+    }
+
+    /**
+     * @brief Returns the slot of an index, allocating its segment if needed.
+     */
+    Slot& _slot(std::size_t index) {
+        auto [segment, offset] = _locate(index);
+        Slot* slots = _segments[segment].load(std::memory_order_acquire);
+        if (slots == nullptr) {
+            Slot* allocated = new Slot[std::size_t(1) << (segment + first_segment_bits)];
+            if (_segments[segment].compare_exchange_strong(slots, allocated, std::memory_order_acq_rel)) {
+                slots = allocated;
+            } else {
+                delete[] allocated;  // another thread won the race; slots now holds its segment
+            }
+        }
+        return slots[offset];
+    }
+
+    std::array<std::atomic<Slot*>, max_segments> _segments;
+    std::atomic<std::size_t> _filled{0};
+};
+
+#endif // CONCURRENT_MEMO_H
@@ -0,0 +1,140 @@
+/**
+ * @file double_double.h
+ * @brief A floating-point type that carries about 106 significant bits as the unevaluated sum of two doubles.
+ * @details A DoubleDouble holds hi + lo with |lo| <= ulp(hi) / 2. Sums and products are made exact with the
+ * error-free transformations two_sum and two_product (the latter on a fused multiply-add), so every operation
+ * costs a handful of double operations and keeps the speed of hardware arithmetic, unlike software quad
+ * precision.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DOUBLE_DOUBLE_H
+#define DOUBLE_DOUBLE_H
+
+#include <cmath>
+
+/**
+ * @brief A double-double number, hi + lo.
+ */
+class DoubleDouble {
+public:
+    /**
+     * @brief Constructs the value of a double, which is exact.
+     */
+    constexpr DoubleDouble(double value = 0) : _hi(value), _lo(0) {}
+
+    /**
+     * @brief Constructs a value from its two parts, which must not overlap.
+     */
+    constexpr DoubleDouble(double hi, double lo) : _hi(hi), _lo(lo) {}
+
+    /**
+     * @brief Returns the leading part, the value rounded to double.
+     */
+    constexpr double hi() const {
+        return _hi;
+    }
+
+    /**
+     * @brief Returns the trailing part.
+     */
+    constexpr double lo() const {
+        return _lo;
+    }
+
+    explicit constexpr operator double() const {
+        return _hi;
+    }
+
+    /**
+     * @brief Returns a + b exactly as a sum and its rounding error.
+     */
+    static DoubleDouble two_sum(double a, double b) {
+        double s = a + b;
+        double v = s - a;
+        return {s, (a - (s - v)) + (b - v)};
+    }
+
+    /**
+     * @brief Returns a + b exactly as a sum and its rounding error, for |a| >= |b|.
+     */
+    static DoubleDouble fast_two_sum(double a, double b) {
+        double s = a + b;
+        return {s, b - (s - a)};
+    }
+
+    /**
+     * @brief Returns a * b exactly as a product and its rounding error.
+     */
+    static DoubleDouble two_product(double a, double b) {
+        double p = a * b;
+        return {p, std::fma(a, b, -p)};
+    }
+
+    friend DoubleDouble operator-(DoubleDouble a) {
+        return {-a._hi, -a._lo};
+    }
+
+    friend DoubleDouble operator+(DoubleDouble a, DoubleDouble b) {
+        DoubleDouble s = two_sum(a._hi, b._hi);
+        DoubleDouble t = two_sum(a._lo, b._lo);
+        s = fast_two_sum(s._hi, s._lo + t._hi);
+        return fast_two_sum(s._hi, s._lo + t._lo);
+    }
+
+    friend DoubleDouble operator-(DoubleDouble a, DoubleDouble b) {
+        return a + -b;
+    }
+
+    friend DoubleDouble operator*(DoubleDouble a, DoubleDouble b) {
+        DoubleDouble p = two_product(a._hi, b._hi);
+        return fast_two_sum(p._hi, p._lo + (a._hi * b._lo + a._lo * b._hi));
+    }
+
+    /**
+     * @brief Divides with two quotient digits, a correction after the first.
+     */
+    friend DoubleDouble operator/(DoubleDouble a, DoubleDouble b) {
+        double q1 = a._hi / b._hi;
+        DoubleDouble r = a - b * q1;
+        double q2 = r._hi / b._hi;
+        r = r - b * q2;
+        double q3 = r._hi / b._hi;
+        DoubleDouble q = fast_two_sum(q1, q2);
+        return q + q3;
+    }
+
+    DoubleDouble& operator+=(DoubleDouble other) {
+        return *this = *this + other;
+    }
+
+    DoubleDouble& operator-=(DoubleDouble other) {
+        return *this = *this - other;
+    }
+
+    DoubleDouble& operator*=(DoubleDouble other) {
+        return *this = *this * other;
+    }
+
+    DoubleDouble& operator/=(DoubleDouble other) {
+        return *this = *this / other;
+    }
+
+private:
+    double _hi;
+    double _lo;
+};
+
+#endif // DOUBLE_DOUBLE_H
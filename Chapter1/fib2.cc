@@ -20,18 +20,7 @@
 #include <cstdlib>
 #include <iostream>
 
-/**
- * Calculates the nth Fibonacci number recursively.
- * @param n The index of the Fibonacci number to calculate.
- * @return The nth Fibonacci number.
- */
-int fib2(int n) {
-    if (n < 2)  // base case
-        return n;
-    
-    return fib2(n - 1) + fib2(n - 2);  // recursive case
-}
-
+#include "fib2.h"
 
 /**
  * @brief The main function that calls the fib2 function and prints its result.
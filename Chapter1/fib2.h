@@ -0,0 +1,35 @@
+/**
+ * @file fib2.h
+ * @brief A recursive function that calculates the nth Fibonacci number.
+ * @details A recursive function that calculates the nth Fibonacci number.
+ * @copyright Copyright 2023 Kyungwon Chun
+ * 
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIB2_H
+#define FIB2_H
+
+/**
+ * Calculates the nth Fibonacci number recursively.
+ * @param n The index of the Fibonacci number to calculate.
+ * @return The nth Fibonacci number.
+ */
+inline int fib2(int n) {
+    if (n < 2)  // base case
+        return n;
+    
+    return fib2(n - 1) + fib2(n - 2);  // recursive case
+}
+
+#endif // FIB2_H
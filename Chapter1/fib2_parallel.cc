@@ -0,0 +1,88 @@
+/**
+ * @file fib2_parallel.cc
+ * @brief A program that runs the fib2 recursion in parallel on a work-stealing scheduler.
+ * @details Each call above a sequential cutoff spawns fib(n - 1) as a task and computes fib(n - 2) itself; below the cutoff it calls the sequential fib2. The program times the sequential fib2 and the parallel version for a growing number of workers, and prints the speedup together with the tasks executed, steals and idle time of every worker.
+ * @copyright Copyright 2023 Kyungwon Chun
+ * 
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include "benchmark.h"
+#include "fib2.h"
+#include "work_stealing.h"
+
+/**
+ * Calculates the nth Fibonacci number recursively, spawning one branch of every call above the cutoff.
+ * @param n The index of the Fibonacci number to calculate.
+ * @param cutoff Calls with n below this value run the sequential fib2.
+ * @return The nth Fibonacci number.
+ */
+int fib2_parallel(int n, int cutoff) {
+    if (n < cutoff)  // too small to be worth a task
+        return fib2(n);
+
+    int x = 0;
+    TaskGroup group;
+    group.spawn([&x, n, cutoff] { x = fib2_parallel(n - 1, cutoff); });
+    int y = fib2_parallel(n - 2, cutoff);
+    group.sync();
+    return x + y;
+}
+
+/**
+ * @brief The main function that measures the scaling of fib2_parallel against fib2.
+ * 
+ * @param argc The number of command-line arguments provided.
+ * @param argv An array of strings containing the command-line arguments.
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    constexpr int n = 40;
+    constexpr int cutoff = 20;
+
+    Stopwatch watch;
+    int expected = fib2(n);
+    double sequential = watch.seconds();
+    std::cout << "fib2(" << n << ") = " << expected << " in " << sequential << " s (sequential)" << std::endl;
+
+    const unsigned max_workers = std::max(4u, std::thread::hardware_concurrency());
+    for (unsigned workers = 1; workers <= max_workers; workers *= 2) {
+        Scheduler scheduler(workers);
+        int result = 0;
+        watch.reset();
+        scheduler.run([&] { result = fib2_parallel(n, cutoff); });
+        double parallel = watch.seconds();
+        if (result != expected) {
+            std::cerr << "fib2_parallel returned " << result << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::cout << std::endl << workers << " workers: " << parallel << " s, speedup " << std::fixed
+                  << std::setprecision(2) << sequential / parallel << std::defaultfloat << std::endl;
+        std::cout << std::setw(8) << "worker" << std::setw(12) << "tasks" << std::setw(10) << "steals"
+                  << std::setw(12) << "idle s" << std::endl;
+        auto stats = scheduler.stats();
+        for (unsigned i = 0; i < stats.size(); ++i) {
+            std::cout << std::setw(8) << i << std::setw(12) << stats[i].tasks_executed << std::setw(10)
+                      << stats[i].steals << std::setw(12) << std::setprecision(4) << stats[i].idle_seconds << std::endl;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
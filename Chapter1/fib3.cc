@@ -19,21 +19,8 @@
 
 #include <cstdlib>
 #include <iostream>
-#include <map>
 
-std::map<int, int> memo = {{0, 0}, {1, 1}};  // our base cases
-
-/**
- * Calculates the nth Fibonacci number using memoization technique.
- * 
- * @param n The index of the Fibonacci number to be calculated.
- * @return The nth Fibonacci number.
- */
-int fib3(int n) {
-    if (memo.find(n) == memo.end())  // if n is not in the memo
-        memo[n] = fib3(n - 1) + fib3(n - 2);  // memoize
-    return memo[n];  // return the nth Fibonacci number
-}
+#include "fib3.h"
 
 /**
  * @brief The main function that calls the fib3 function and prints its result.
@@ -0,0 +1,39 @@
+/**
+ * @file fib3.h
+ * @brief A memoized recursive function that calculates the nth Fibonacci number.
+ * @details A memoized recursive function that calculates the nth Fibonacci number.
+ * @copyright Copyright 2023 Kyungwon Chun
+ * 
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIB3_H
+#define FIB3_H
+
+#include <map>
+
+inline std::map<int, int> memo = {{0, 0}, {1, 1}};  // our base cases
+
+/**
+ * Calculates the nth Fibonacci number using memoization technique.
+ * 
+ * @param n The index of the Fibonacci number to be calculated.
+ * @return The nth Fibonacci number.
+ */
+inline int fib3(int n) {
+    if (memo.find(n) == memo.end())  // if n is not in the memo
+        memo[n] = fib3(n - 1) + fib3(n - 2);  // memoize
+    return memo[n];  // return the nth Fibonacci number
+}
+
+#endif // FIB3_H
@@ -0,0 +1,37 @@
+/**
+ * @file fib4.cc
+ * @brief A program that calculates the nth Fibonacci number using a memoize wrapper.
+ * @details This program calls fib4 to calculate and print the 5th and the 50th Fibonacci numbers to the console, followed by the hit and miss counts of its cache.
+ * @copyright Copyright 2023 Kyungwon Chun
+ * 
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include <iostream>
+
+#include "fib4.h"
+
+/**
+ * @brief The main function that calls the fib4 function and prints its results.
+ * 
+ * @param argc The number of command-line arguments provided.
+ * @param argv An array of strings containing the command-line arguments.
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    std::cout << fib4(5) << std::endl;
+    std::cout << fib4(50) << std::endl;
+    std::cout << "hits: " << fib4.stats().hits << ", misses: " << fib4.stats().misses << std::endl;
+    return EXIT_SUCCESS;
+}
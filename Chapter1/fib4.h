@@ -0,0 +1,39 @@
+/**
+ * @file fib4.h
+ * @brief A memoized recursive function that calculates the nth Fibonacci number with a reusable memoize wrapper.
+ * @details fib4.py decorates the recursive function with functools.lru_cache; here the same function is wrapped with memoize() and an unbounded FlatHashCache.
+ * @copyright Copyright 2023 Kyungwon Chun
+ * 
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIB4_H
+#define FIB4_H
+
+#include <cstdint>
+
+#include "memoize.h"
+
+/**
+ * Calculates the nth Fibonacci number recursively, with every result cached by memoize.
+ * 
+ * @param n The index of the Fibonacci number to calculate.
+ * @return The nth Fibonacci number.
+ */
+inline auto fib4 = memoize<FlatHashCache<int, std::uint64_t>>([](auto& self, int n) -> std::uint64_t {
+    if (n < 2)  // base case
+        return n;
+    return self(n - 2) + self(n - 1);  // recursive case
+});
+
+#endif // FIB4_H
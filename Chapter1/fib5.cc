@@ -20,22 +20,7 @@
 #include <cstdlib>
 #include <iostream>
 
-/**
- * Calculates the nth Fibonacci number iteratively.
- * @param n The index of the Fibonacci number to calculate.
- * @return The nth Fibonacci number.
- */
-int fib5(int n) {
-    if (n == 0) return n;  // special case
-    int last = 0;  // initially set to fib(0)
-    int next = 1;  // initially set to fib(1)
-    for (int i = 1; i < n; ++i) {
-        int tmp = next;
-        next = last + next;
-        last = tmp;
-    }
-    return next;
-}
+#include "fib5.h"
 
 /**
  * @brief The main function that calls the fib5 function and prints its result.
@@ -0,0 +1,40 @@
+/**
+ * @file fib5.h
+ * @brief An iterative function that calculates the nth Fibonacci number.
+ * @details An iterative function that calculates the nth Fibonacci number.
+ * @copyright Copyright 2023 Kyungwon Chun
+ * 
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#ifndef FIB5_H
+#define FIB5_H
+
+/**
+ * Calculates the nth Fibonacci number iteratively.
+ * @param n The index of the Fibonacci number to calculate.
+ * @return The nth Fibonacci number.
+ */
+inline int fib5(int n) {
+    if (n == 0) return n;  // special case
+    int last = 0;  // initially set to fib(0)
+    int next = 1;  // initially set to fib(1)
+    for (int i = 1; i < n; ++i) {
+        int tmp = next;
+        next = last + next;
+        last = tmp;
+    }
+    return next;
+}
+
+#endif // FIB5_H
@@ -0,0 +1,46 @@
+/**
+ * @file fib6.cc
+ * @brief A program that generates Fibonacci numbers lazily.
+ * @details This program prints the Fibonacci numbers from fib(0) to fib(50) as they are generated, followed by the first even Fibonacci numbers selected with a range filter.
+ * @copyright Copyright 2023 Kyungwon Chun
+ * 
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <ranges>
+
+#include "fib6.h"
+
+/**
+ * @brief The main function that prints the terms produced by fib6.
+ * 
+ * @param argc The number of command-line arguments provided.
+ * @param argv An array of strings containing the command-line arguments.
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    for (std::uint64_t i : fib6(50)) {
+        std::cout << i << std::endl;
+    }
+
+    auto is_even = [](std::uint64_t i) { return i % 2 == 0; };
+    for (std::uint64_t i : FibonacciView() | std::views::filter(is_even) | std::views::take(5)) {
+        std::cout << i << " ";
+    }
+    std::cout << std::endl;
+
+    return EXIT_SUCCESS;
+}
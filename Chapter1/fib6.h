@@ -0,0 +1,111 @@
+/**
+ * @file fib6.h
+ * @brief A lazy range of Fibonacci numbers, the C++ counterpart of the generator in fib6.py.
+ * @details FibonacciView is an infinite std::ranges view whose iterator holds the two most recent terms, so
+ * every increment computes one new term in place and nothing is allocated for built-in value types. It
+ * composes with standard range adaptors such as std::views::take and std::views::filter.
+ * @copyright Copyright 2023 Kyungwon Chun
+ * 
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIB6_H
+#define FIB6_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <utility>
+
+/**
+ * @brief An infinite view of the Fibonacci numbers fib(0), fib(1), fib(2), ...
+ * @details Terms past max_fib_index<T>() wrap around for unsigned built-in types, so bound the view with
+ * std::views::take, or use a BigUnsigned value type for exact terms of any size.
+ * 
+ * @tparam T The type of the terms.
+ */
+template <typename T = std::uint64_t>
+class FibonacciView : public std::ranges::view_interface<FibonacciView<T>> {
+public:
+    /**
+     * @brief A forward iterator that yields one Fibonacci number per increment.
+     */
+    class iterator {
+    public:
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using iterator_concept = std::forward_iterator_tag;
+
+        iterator() = default;
+
+        const T& operator*() const {
+            return _last;
+        }
+
+        iterator& operator++() {
+            T tmp = _last + _next;
+            _last = std::move(_next);
+            _next = std::move(tmp);
+            ++_index;
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        friend bool operator==(const iterator& lhs, const iterator& rhs) {
+            return lhs._index == rhs._index;
+        }
+
+    private:
+        T _last = T(0);  // initially set to fib(0)
+        T _next = T(1);  // initially set to fib(1)
+        std::size_t _index = 0;
+    };
+
+    /**
+     * @brief Returns an iterator to fib(0).
+     * 
+     * @return iterator The first position of the view.
+     */
+    iterator begin() const {
+        return iterator();
+    }
+
+    /**
+     * @brief Returns the sentinel of the view, which is never reached.
+     * 
+     * @return std::unreachable_sentinel_t The sentinel.
+     */
+    std::unreachable_sentinel_t end() const {
+        return std::unreachable_sentinel;
+    }
+};
+
+/**
+ * @brief Lazily generates the Fibonacci numbers fib(0) through fib(n).
+ * 
+ * @tparam T The type of the terms.
+ * @param n The index of the last Fibonacci number to generate.
+ * @return A view of n + 1 Fibonacci numbers.
+ */
+template <typename T = std::uint64_t>
+auto fib6(std::size_t n) {
+    return FibonacciView<T>() | std::views::take(n + 1);
+}
+
+#endif // FIB6_H
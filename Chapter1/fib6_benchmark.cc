@@ -0,0 +1,77 @@
+/**
+ * @file fib6_benchmark.cc
+ * @brief A program that compares generating a sequence of Fibonacci numbers lazily against calling fib5 for every term.
+ * @details For every sequence length this program times filling a std::vector by calling fib5(i) for each i, copying the lazy fib6 view into a std::vector, and consuming the view directly without storing it. The fib5 column stops at 47 terms, the last one that fits in an int.
+ * @copyright Copyright 2023 Kyungwon Chun
+ * 
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+#include "benchmark.h"
+#include "fib5.h"
+#include "fib6.h"
+
+/**
+ * @brief The main function that times every way of producing the first terms of the sequence.
+ * 
+ * @param argc The number of command-line arguments provided.
+ * @param argv An array of strings containing the command-line arguments.
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    constexpr int max_int_terms = 47;  // fib(46) is the last term that fits in an int
+
+    std::cout << std::setw(10) << "terms" << std::setw(16) << "fib5 loop ns" << std::setw(16) << "fib6 copy ns"
+              << std::setw(16) << "fib6 stream ns" << std::endl;
+    for (int terms : {10, 47, 1000, 1000000}) {
+        double loop_time = -1;
+        if (terms <= max_int_terms) {
+            loop_time = seconds_per_call([terms] {
+                std::vector<int> sequence;
+                sequence.reserve(terms);
+                for (int i = 0; i < terms; ++i)
+                    sequence.push_back(fib5(i));
+                do_not_optimize(sequence.back());
+            });
+        }
+        double copy_time = seconds_per_call([terms] {
+            std::vector<std::uint64_t> sequence;
+            sequence.reserve(terms);
+            std::ranges::copy(fib6(terms - 1), std::back_inserter(sequence));
+            do_not_optimize(sequence.back());
+        });
+        double stream_time = seconds_per_call([terms] {
+            std::uint64_t checksum = 0;  // terms past fib(93) wrap, which is fine for a checksum
+            for (std::uint64_t i : fib6(terms - 1))
+                checksum ^= i;
+            do_not_optimize(checksum);
+        });
+
+        std::cout << std::setw(10) << terms << std::fixed << std::setprecision(1) << std::setw(16);
+        if (loop_time < 0)
+            std::cout << "-";
+        else
+            std::cout << loop_time * 1e9;
+        std::cout << std::setw(16) << copy_time * 1e9 << std::setw(16) << stream_time * 1e9 << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,110 @@
+/**
+ * @file fib_batch.cc
+ * @brief A program that measures the throughput of batched fib(n) mod m queries.
+ * @details For three workloads (a few shared moduli, a thousand small moduli, and all-distinct 64-bit moduli) this program answers the same queries one at a time with fib_mod and as a batch with FibModBatch, twice so the second batch finds its Pisano periods cached. It checks that all answers agree and prints queries per second.
+ * @copyright Copyright 2023 Kyungwon Chun
+ * 
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark.h"
+#include "fib_batch.h"
+#include "fib_fast.h"
+
+using Queries = std::vector<std::pair<std::uint64_t, std::uint64_t>>;
+
+/**
+ * @brief Generates queries with uniformly random n and a modulus drawn from the given generator.
+ * 
+ * @tparam ModulusGenerator The type of a callable that returns a modulus.
+ * @param count The number of queries.
+ * @param random The random engine.
+ * @param modulus The callable that returns the modulus of the next query.
+ * @return Queries The generated queries.
+ */
+template <typename ModulusGenerator>
+Queries make_queries(std::size_t count, std::mt19937_64& random, ModulusGenerator modulus) {
+    Queries queries(count);
+    for (auto& query : queries)
+        query = {random(), modulus()};
+    return queries;
+}
+
+/**
+ * @brief Answers the queries one at a time and as batches, and prints the throughput of each.
+ * 
+ * @param name The name of the workload.
+ * @param queries The queries.
+ * @return bool True if every method gave the same answers.
+ */
+bool run(const std::string& name, const Queries& queries) {
+    std::vector<std::uint64_t> expected(queries.size());
+    Stopwatch watch;
+    for (std::size_t i = 0; i < queries.size(); ++i)
+        expected[i] = fib_mod(queries[i].first, queries[i].second);
+    double single_rate = queries.size() / watch.seconds();
+
+    FibModBatch batch;
+    std::vector<std::uint64_t> cold = batch.solve(queries);
+    FibBatchStats cold_stats = batch.last_stats();
+    std::vector<std::uint64_t> warm = batch.solve(queries);
+    FibBatchStats warm_stats = batch.last_stats();
+
+    std::cout << std::setw(16) << name << std::setw(10) << cold_stats.moduli << std::fixed << std::setprecision(2)
+              << std::setw(14) << single_rate / 1e6 << std::setw(14) << cold_stats.queries_per_second / 1e6
+              << std::setw(14) << warm_stats.queries_per_second / 1e6 << std::setw(12) << warm_stats.period_cache_hits << std::endl;
+    return cold == expected && warm == expected;
+}
+
+/**
+ * @brief The main function that runs every workload.
+ * 
+ * @param argc The number of command-line arguments provided.
+ * @param argv An array of strings containing the command-line arguments.
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    std::cout << "pisano period of 10 = " << FibModBatch::pisano_period(10) << std::endl;
+    std::cout << "pisano period of 1000000007 = " << FibModBatch::pisano_period(1000000007) << std::endl;
+
+    constexpr std::size_t count = 1 << 20;
+    std::mt19937_64 random(42);
+
+    const std::vector<std::uint64_t> shared_moduli{1000000007, 998244353, 1000000009, 4294967291ULL, 65536, 100000, 1ULL << 61};
+    std::uniform_int_distribution<std::size_t> pick_shared(0, shared_moduli.size() - 1);
+    std::vector<std::uint64_t> small_moduli(1000);
+    for (auto& m : small_moduli)
+        m = 2 + random() % 1000000;
+    std::uniform_int_distribution<std::size_t> pick_small(0, small_moduli.size() - 1);
+
+    std::cout << std::setw(16) << "workload" << std::setw(10) << "moduli" << std::setw(14) << "single Mq/s"
+              << std::setw(14) << "cold Mq/s" << std::setw(14) << "warm Mq/s" << std::setw(12) << "cache hits" << std::endl;
+    bool ok = run("shared moduli", make_queries(count, random, [&] { return shared_moduli[pick_shared(random)]; }));
+    ok &= run("small moduli", make_queries(count, random, [&] { return small_moduli[pick_small(random)]; }));
+    ok &= run("distinct moduli", make_queries(count, random, [&] { return random() | 1; }));
+
+    if (!ok) {
+        std::cerr << "batched answers differ from fib_mod" << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,356 @@
+/**
+ * @file fib_batch.h
+ * @brief Answers large batches of fib(n) mod m queries.
+ * @details FibModBatch groups the queries of a batch by modulus and prepares each group once: the Pisano period
+ * (the period of the Fibonacci sequence modulo m) shrinks every n of the group, and a table of (F(k), F(k+1))
+ * pairs for k = j * 256^w turns each query into at most eight table combinations instead of one doubling step
+ * per bit of n. Pisano periods are cached across batches, and the groups and queries are spread across threads.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIB_BATCH_H
+#define FIB_BATCH_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A pair of consecutive Fibonacci numbers (F(k), F(k + 1)) modulo some m.
+ */
+struct FibPair {
+    std::uint64_t current;
+    std::uint64_t next;
+
+    friend bool operator==(const FibPair&, const FibPair&) = default;
+};
+
+/**
+ * @brief Modular arithmetic on values below m.
+ *
+ * @tparam Wide True if m may exceed 2^32, in which case products are reduced through 128 bits.
+ */
+template <bool Wide>
+struct ModArithmetic {
+    std::uint64_t m;
+
+    std::uint64_t multiply(std::uint64_t a, std::uint64_t b) const {
+        if constexpr (Wide)
+            return static_cast<std::uint64_t>(static_cast<unsigned __int128>(a) * b % m);
+        else
+            return a * b % m;
+    }
+
+    std::uint64_t add(std::uint64_t a, std::uint64_t b) const {
+        return a >= m - b ? a - (m - b) : a + b;
+    }
+
+    std::uint64_t subtract(std::uint64_t a, std::uint64_t b) const {
+        return a >= b ? a - b : a + (m - b);
+    }
+
+    /**
+     * @brief Returns (F(a + b), F(a + b + 1)) from (F(a), F(a + 1)) and (F(b), F(b + 1)).
+     */
+    FibPair combine(const FibPair& x, const FibPair& y) const {
+        std::uint64_t previous = subtract(x.next, x.current);  // F(a - 1)
+        return {add(multiply(x.current, y.next), multiply(previous, y.current)),
+                add(multiply(x.next, y.next), multiply(x.current, y.current))};
+    }
+
+    /**
+     * @brief Returns (F(n), F(n + 1)) with the fast doubling method.
+     */
+    FibPair pair(std::uint64_t n) const {
+        FibPair result{0, 1 % m};
+        for (int i = std::bit_width(n) - 1; i >= 0; --i) {
+            std::uint64_t a = result.current, b = result.next;
+            std::uint64_t even = multiply(a, subtract(add(b, b), a));  // F(2k)
+            std::uint64_t odd = add(multiply(a, a), multiply(b, b));  // F(2k + 1)
+            result = (n >> i) & 1 ? FibPair{odd, add(even, odd)} : FibPair{even, odd};
+        }
+        return result;
+    }
+};
+
+/**
+ * @brief Throughput figures of the most recent batch.
+ */
+struct FibBatchStats {
+    std::size_t queries = 0;
+    std::size_t moduli = 0;  // distinct moduli in the batch
+    std::size_t period_cache_hits = 0;  // groups whose Pisano period was already cached
+    double seconds = 0;
+    double queries_per_second = 0;
+};
+
+/**
+ * @brief Answers batches of fib(n) mod m queries.
+ */
+class FibModBatch {
+public:
+    /**
+     * @brief Moduli up to this value get a Pisano period; larger ones are evaluated without reduction.
+     */
+    static constexpr std::uint64_t max_period_modulus = std::uint64_t(1) << 32;
+
+    /**
+     * @brief Groups with at least this many queries compute a missing Pisano period.
+     */
+    static constexpr std::size_t period_group_size = 256;
+
+    /**
+     * @brief Groups with at least this many queries build a window table.
+     */
+    static constexpr std::size_t table_group_size = 64;
+
+    /**
+     * @brief Constructs a FibModBatch.
+     *
+     * @param threads The number of worker threads; zero means one per hardware thread.
+     */
+    explicit FibModBatch(unsigned threads = 0)
+        : _threads(threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency())) {}
+
+    /**
+     * @brief Answers a batch of queries.
+     *
+     * @param queries The (n, m) pairs.
+     * @return std::vector<std::uint64_t> fib(n) mod m for every query, in the same order.
+     * @throws std::invalid_argument If any modulus is zero.
+     */
+    std::vector<std::uint64_t> solve(const std::vector<std::pair<std::uint64_t, std::uint64_t>>& queries) {
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& query : queries) {
+            if (query.second == 0)
+                throw std::invalid_argument("Modulus must be non-zero");
+        }
+
+        std::vector<std::uint32_t> order(queries.size());  // query indices sorted by modulus
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) {
+            return queries[a].second < queries[b].second;
+        });
+
+        std::vector<Group> groups;
+        std::vector<std::uint32_t> group_of(order.size());  // group of each position in order
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            std::uint64_t m = queries[order[i]].second;
+            if (groups.empty() || groups.back().m != m)
+                groups.push_back({m, i, i, 0, {}});
+            groups.back().end = i + 1;
+            group_of[i] = static_cast<std::uint32_t>(groups.size() - 1);
+        }
+
+        std::size_t cache_hits = 0;
+        for (Group& group : groups) {
+            auto cached = _periods.find(group.m);
+            if (cached != _periods.end()) {
+                group.period = cached->second;
+                ++cache_hits;
+            }
+        }
+
+        _parallel_for(groups.size(), 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t g = begin; g < end; ++g)
+                _prepare(groups[g]);
+        });
+        for (const Group& group : groups) {
+            if (group.period != 0)
+                _periods.emplace(group.m, group.period);
+        }
+
+        std::vector<std::uint64_t> results(queries.size());
+        _parallel_for(order.size(), 4096, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const Group& group = groups[group_of[i]];
+                std::uint64_t n = queries[order[i]].first;
+                results[order[i]] = group.m > max_period_modulus ? _answer(ModArithmetic<true>{group.m}, group, n)
+                                                                 : _answer(ModArithmetic<false>{group.m}, group, n);
+            }
+        });
+
+        _stats.queries = queries.size();
+        _stats.moduli = groups.size();
+        _stats.period_cache_hits = cache_hits;
+        _stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        _stats.queries_per_second = _stats.seconds > 0 ? queries.size() / _stats.seconds : 0;
+        return results;
+    }
+
+    /**
+     * @brief Returns the throughput figures of the most recent batch.
+     *
+     * @return const FibBatchStats& The statistics.
+     */
+    const FibBatchStats& last_stats() const {
+        return _stats;
+    }
+
+    /**
+     * @brief Returns the number of cached Pisano periods.
+     *
+     * @return std::size_t The size of the cache.
+     */
+    std::size_t cached_periods() const {
+        return _periods.size();
+    }
+
+    /**
+     * @brief Computes the Pisano period of m, the length of the cycle of fib(n) mod m.
+     * @details m is factored by trial division, and the period of every prime power p^k is taken as
+     * p^(k-1) * pi(p), which is always a multiple of the exact period (and equal to it for every p known).
+     * pi(p) itself is found by dividing the bound p - 1 or 2(p + 1) by its prime factors while the sequence
+     * still returns to (0, 1).
+     *
+     * @param m The modulus, at most max_period_modulus.
+     * @return std::uint64_t The Pisano period of m.
+     */
+    static std::uint64_t pisano_period(std::uint64_t m) {
+        std::uint64_t period = 1;
+        for (auto [p, k] : _factorize(m)) {
+            std::uint64_t prime_power_period = _prime_period(p);
+            for (int i = 1; i < k; ++i)
+                prime_power_period *= p;
+            period = std::lcm(period, prime_power_period);
+        }
+        return period;
+    }
+
+private:
+    /**
+     * @brief The shared state of all queries with the same modulus.
+     */
+    struct Group {
+        std::uint64_t m;
+        std::size_t begin;  // range of positions in the sorted order
+        std::size_t end;
+        std::uint64_t period;  // zero if unknown
+        std::vector<std::array<FibPair, 256>> windows;  // windows[w][j] = pair for j * 256^w
+    };
+
+    static std::vector<std::pair<std::uint64_t, int>> _factorize(std::uint64_t n) {
+        std::vector<std::pair<std::uint64_t, int>> factors;
+        for (std::uint64_t p = 2; p * p <= n; p += (p == 2 ? 1 : 2)) {
+            if (n % p == 0) {
+                int k = 0;
+                while (n % p == 0) {
+                    n /= p;
+                    ++k;
+                }
+                factors.emplace_back(p, k);
+            }
+        }
+        if (n > 1)
+            factors.emplace_back(n, 1);
+        return factors;
+    }
+
+    static std::uint64_t _prime_period(std::uint64_t p) {
+        if (p == 2)
+            return 3;
+        if (p == 5)
+            return 20;
+        ModArithmetic<true> arithmetic{p};
+        std::uint64_t period = (p % 5 == 1 || p % 5 == 4) ? p - 1 : 2 * (p + 1);
+        for (auto [q, k] : _factorize(period)) {
+            for (int i = 0; i < k && arithmetic.pair(period / q) == FibPair{0, 1}; ++i)
+                period /= q;
+        }
+        return period;
+    }
+
+    /**
+     * @brief Computes the Pisano period and the window table of a group if the group is large enough.
+     */
+    void _prepare(Group& group) const {
+        std::size_t size = group.end - group.begin;
+        if (group.period == 0 && size >= period_group_size && group.m <= max_period_modulus)
+            group.period = pisano_period(group.m);
+        if (size >= table_group_size) {
+            if (group.m > max_period_modulus)
+                _build_windows(ModArithmetic<true>{group.m}, group);
+            else
+                _build_windows(ModArithmetic<false>{group.m}, group);
+        }
+    }
+
+    template <bool Wide>
+    static void _build_windows(const ModArithmetic<Wide>& arithmetic, Group& group) {
+        int bits = group.period != 0 ? std::bit_width(group.period - 1) : 64;
+        group.windows.resize((bits + 7) / 8);
+        FibPair step{1 % group.m, 1 % group.m};  // (F(1), F(2))
+        for (auto& window : group.windows) {
+            window[0] = {0, 1 % group.m};
+            window[1] = step;
+            for (int j = 2; j < 256; ++j)
+                window[j] = arithmetic.combine(window[j - 1], step);
+            step = arithmetic.combine(window[255], step);
+        }
+    }
+
+    template <bool Wide>
+    static std::uint64_t _answer(const ModArithmetic<Wide>& arithmetic, const Group& group, std::uint64_t n) {
+        if (group.period != 0)
+            n %= group.period;
+        if (group.windows.empty())
+            return arithmetic.pair(n).current;
+        FibPair result{0, 1 % group.m};
+        for (std::size_t w = 0; n != 0; ++w, n >>= 8) {
+            if (n & 0xff)
+                result = arithmetic.combine(result, group.windows[w][n & 0xff]);
+        }
+        return result.current;
+    }
+
+    /**
+     * @brief Runs body(begin, end) over chunks of [0, count) on the worker threads.
+     */
+    template <typename Body>
+    void _parallel_for(std::size_t count, std::size_t chunk, Body&& body) const {
+        unsigned threads = static_cast<unsigned>(std::min<std::size_t>(_threads, (count + chunk - 1) / chunk));
+        if (threads <= 1) {
+            body(0, count);
+            return;
+        }
+        std::atomic<std::size_t> next{0};
+        auto worker = [&] {
+            for (std::size_t begin; (begin = next.fetch_add(chunk)) < count;)
+                body(begin, std::min(count, begin + chunk));
+        };
+        std::vector<std::thread> workers;
+        for (unsigned t = 1; t < threads; ++t)
+            workers.emplace_back(worker);
+        worker();
+        for (std::thread& t : workers)
+            t.join();
+    }
+
+    unsigned _threads;
+    std::unordered_map<std::uint64_t, std::uint64_t> _periods;
+    FibBatchStats _stats;
+};
+
+#endif // FIB_BATCH_H
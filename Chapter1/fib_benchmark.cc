@@ -0,0 +1,88 @@
+/**
+ * @file fib_benchmark.cc
+ * @brief A program that compares the latency of the Fibonacci implementations.
+ * @details This program times fib2 (naive recursion), fib3 (memoized recursion with a cold memo), fib5 (iteration), fib_fast (fast doubling) and fib_lookup (compile-time table) for a range of n and prints one row per n. The int based versions are only timed while their result fits in an int, and fib2 is only timed for small n because it is exponential.
+ * @copyright Copyright 2023 Kyungwon Chun
+ * 
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#include "benchmark.h"
+#include "fib2.h"
+#include "fib3.h"
+#include "fib5.h"
+#include "fib_fast.h"
+#include "fib_table.h"
+
+/**
+ * @brief Prints a latency in nanoseconds, or a dash when the implementation was not timed.
+ * 
+ * @param seconds The latency in seconds, or a negative value if it was not measured.
+ */
+void print_latency(double seconds) {
+    std::cout << std::setw(14);
+    if (seconds < 0)
+        std::cout << "-";
+    else
+        std::cout << std::fixed << std::setprecision(1) << seconds * 1e9;
+}
+
+/**
+ * @brief The main function that times every Fibonacci implementation and prints a table of latencies.
+ * 
+ * @param argc The number of command-line arguments provided.
+ * @param argv An array of strings containing the command-line arguments.
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    constexpr int max_int_index = 46;  // fib(47) overflows a 32-bit int
+    constexpr int max_fib2_index = 30;  // fib2 is exponential, keep the run short
+
+    std::cout << std::setw(4) << "n" << std::setw(14) << "fib2 ns" << std::setw(14) << "fib3 ns"
+              << std::setw(14) << "fib5 ns" << std::setw(14) << "fast64 ns" << std::setw(14) << "fast128 ns"
+              << std::setw(14) << "table ns" << std::endl;
+    for (int n : {5, 10, 20, 30, 46, 93, 186}) {
+        double fib2_time = -1, fib3_time = -1, fib5_time = -1, fast64_time = -1;
+        if (n <= max_fib2_index) {
+            fib2_time = seconds_per_call([n] { do_not_optimize(fib2(n)); });
+        }
+        if (n <= max_int_index) {
+            fib3_time = seconds_per_call([n] {
+                memo = {{0, 0}, {1, 1}};  // cold memo so every call does the full recursion
+                do_not_optimize(fib3(n));
+            });
+            fib5_time = seconds_per_call([n] { do_not_optimize(fib5(n)); });
+        }
+        if (n <= static_cast<int>(max_fib_index<std::uint64_t>())) {
+            fast64_time = seconds_per_call([n] { do_not_optimize(fib_fast<std::uint64_t>(n)); });
+        }
+        double fast128_time = seconds_per_call([n] { do_not_optimize(fib_fast<unsigned __int128>(n)); });
+        double table_time = seconds_per_call([n] { do_not_optimize(fib_lookup<unsigned __int128>(n)); });
+
+        std::cout << std::setw(4) << n;
+        print_latency(fib2_time);
+        print_latency(fib3_time);
+        print_latency(fib5_time);
+        print_latency(fast64_time);
+        print_latency(fast128_time);
+        print_latency(table_time);
+        std::cout << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file fib_big.cc
+ * @brief A program that calculates exact Fibonacci numbers of any size.
+ * @details Given an index on the command line, this program writes that Fibonacci number to standard output in decimal (or in hexadecimal with --hex) and reports timings on standard error. Without arguments it prints fib(100) and a table of computation and output times for growing n.
+ * @copyright Copyright 2023 Kyungwon Chun
+ * 
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <streambuf>
+#include <string>
+
+#include "benchmark.h"
+#include "fib_big.h"
+
+/**
+ * @brief A stream buffer that discards its input and only counts the characters written to it.
+ */
+class CountingBuffer : public std::streambuf {
+public:
+    /**
+     * @brief Returns the number of characters written so far.
+     * 
+     * @return std::uint64_t The number of characters.
+     */
+    std::uint64_t count() const {
+        return _count;
+    }
+
+protected:
+    std::streamsize xsputn(const char*, std::streamsize n) override {
+        _count += n;
+        return n;
+    }
+
+    int_type overflow(int_type c) override {
+        if (c != traits_type::eof())
+            ++_count;
+        return c;
+    }
+
+private:
+    std::uint64_t _count = 0;
+};
+
+/**
+ * @brief The main function that calculates and prints big Fibonacci numbers.
+ * 
+ * @param argc The number of command-line arguments provided.
+ * @param argv An array of strings containing the command-line arguments: an optional index and an optional --hex flag.
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        std::uint64_t n = std::stoull(argv[1]);
+        bool hex = argc > 2 && std::string(argv[2]) == "--hex";
+
+        Stopwatch watch;
+        BigUnsigned<BinaryRadix> result = fib_big(n);
+        double compute_time = watch.seconds();
+        watch.reset();
+        if (hex)
+            write_hex(std::cout, result);
+        else
+            write_decimal(std::cout, result);
+        std::cout << std::endl;
+        std::cerr << "compute " << compute_time << " s, output " << watch.seconds() << " s" << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    std::cout << "fib(100) = " << fib_big(100) << std::endl;
+
+    std::cout << std::setw(10) << "n" << std::setw(12) << "digits" << std::setw(14) << "binary s"
+              << std::setw(14) << "to decimal s" << std::setw(14) << "decimal s" << std::endl;
+    for (std::uint64_t n : {1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL}) {
+        Stopwatch watch;
+        BigUnsigned<BinaryRadix> binary = fib_big(n);
+        double binary_time = watch.seconds();
+
+        CountingBuffer counter;
+        std::ostream sink(&counter);
+        watch.reset();
+        write_decimal(sink, binary);
+        double convert_time = watch.seconds();
+
+        watch.reset();
+        do_not_optimize(fib_big<DecimalRadix>(n));
+        double decimal_time = watch.seconds();
+
+        std::cout << std::setw(10) << n << std::setw(12) << counter.count() << std::fixed << std::setprecision(4)
+                  << std::setw(14) << binary_time << std::setw(14) << convert_time << std::setw(14) << decimal_time << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
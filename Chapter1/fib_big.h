@@ -0,0 +1,70 @@
+/**
+ * @file fib_big.h
+ * @brief Calculates exact Fibonacci numbers of any size with the fast doubling method.
+ * @details fib_big uses the same doubling identities as fib_fast, but on BigUnsigned values, so the cost is a
+ * logarithmic number of big multiplications. For large operands the three products of a doubling step are
+ * independent and are computed concurrently.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIB_BIG_H
+#define FIB_BIG_H
+
+#include <bit>
+#include <cstdint>
+#include <future>
+#include <thread>
+
+#include "big_unsigned.h"
+
+/**
+ * @brief Calculates the nth Fibonacci number exactly.
+ *
+ * @tparam Radix The limb base of the result; use DecimalRadix when the value will only be printed in decimal.
+ * @param n The index of the Fibonacci number to calculate.
+ * @return BigUnsigned<Radix> The nth Fibonacci number.
+ */
+template <typename Radix = BinaryRadix>
+BigUnsigned<Radix> fib_big(std::uint64_t n) {
+    using Big = BigUnsigned<Radix>;
+    const bool can_parallelize = std::thread::hardware_concurrency() > 1;
+
+    Big a = 0;  // fib(k)
+    Big b = 1;  // fib(k + 1)
+    for (int i = std::bit_width(n) - 1; i >= 1; --i) {
+        Big twice_b_minus_a = b + b - a;
+        Big even, odd;
+        if (can_parallelize && a.limbs().size() >= Big::ntt_threshold) {
+            auto pending_even = std::async(std::launch::async, [&] { return a * twice_b_minus_a; });
+            auto pending_a_squared = std::async(std::launch::async, [&] { return a * a; });
+            Big b_squared = b * b;
+            even = pending_even.get();
+            odd = pending_a_squared.get() + b_squared;
+        } else {
+            even = a * twice_b_minus_a;  // fib(2k)
+            odd = a * a + b * b;  // fib(2k + 1)
+        }
+        if ((n >> i) & 1) {
+            a = odd;
+            b = even + odd;
+        } else {
+            a = std::move(even);
+            b = std::move(odd);
+        }
+    }
+    return (n & 1) ? a * a + b * b : a * (b + b - a);
+}
+
+#endif // FIB_BIG_H
@@ -0,0 +1,50 @@
+/**
+ * @file fib_fast.cc
+ * @brief A program that calculates Fibonacci numbers with the fast doubling method.
+ * @details This program prints the largest Fibonacci numbers that fit in 64 and 128 bits, a Fibonacci number modulo a prime, and shows that an out-of-range request is reported instead of wrapping around.
+ * @copyright Copyright 2023 Kyungwon Chun
+ * 
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+#include "fib_fast.h"
+
+/**
+ * @brief The main function that calls the fast doubling functions and prints their results.
+ * 
+ * @param argc The number of command-line arguments provided.
+ * @param argv An array of strings containing the command-line arguments.
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    constexpr unsigned max64 = max_fib_index<std::uint64_t>();
+    constexpr unsigned max128 = max_fib_index<unsigned __int128>();
+
+    std::cout << "fib(5) = " << fib_fast(5) << std::endl;
+    std::cout << "fib(" << max64 << ") = " << fib_fast<std::uint64_t>(max64) << std::endl;
+    std::cout << "fib(" << max128 << ") = " << to_string(fib_fast<unsigned __int128>(max128)) << std::endl;
+    std::cout << "fib(10^18) mod 1000000007 = " << fib_mod(1000000000000000000ULL, 1000000007ULL) << std::endl;
+
+    try {
+        fib_fast<std::uint64_t>(max64 + 1);
+    } catch (const std::overflow_error& e) {
+        std::cout << "overflow detected: " << e.what() << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file fib_fast.h
+ * @brief Calculates the nth Fibonacci number in O(log n) using the fast doubling method.
+ * @details Fast doubling walks the bits of n from the most significant one and uses the identities
+ * F(2k) = F(k) * (2F(k+1) - F(k)) and F(2k+1) = F(k)^2 + F(k+1)^2. Exact results are available for any
+ * unsigned integer type, including unsigned __int128, and requests whose result would not fit are rejected
+ * instead of wrapping around. A modular variant returns F(n) mod m for any 64-bit modulus.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIB_FAST_H
+#define FIB_FAST_H
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief Returns the largest n for which F(n) is representable in T.
+ *
+ * @tparam T An unsigned integer type.
+ * @return unsigned The largest representable Fibonacci index (93 for uint64_t, 186 for unsigned __int128).
+ */
+template <typename T>
+constexpr unsigned max_fib_index() {
+    static_assert(T(-1) > T(0), "T must be an unsigned integer type");
+    constexpr T max_value = T(-1);
+    T last = 0;  // fib(k)
+    T next = 1;  // fib(k + 1)
+    unsigned k = 0;
+    while (next <= max_value - last) {  // fib(k + 2) still fits
+        T tmp = next;
+        next = last + next;
+        last = tmp;
+        ++k;
+    }
+    return k + 1;
+}
+
+/**
+ * @brief Calculates the nth Fibonacci number exactly in O(log n) steps.
+ * @details The last doubling step only computes the value that is returned, so F(n + 1) is never formed and
+ * every n up to max_fib_index<T>() can be answered.
+ *
+ * @tparam T An unsigned integer type used for the result.
+ * @param n The index of the Fibonacci number to calculate.
+ * @return T The nth Fibonacci number.
+ * @throws std::overflow_error If F(n) does not fit in T.
+ */
+template <typename T = std::uint64_t>
+constexpr T fib_fast(std::uint64_t n) {
+    if (n > max_fib_index<T>())
+        throw std::overflow_error("fib(" + std::to_string(n) + ") does not fit in the result type");
+
+    T a = 0;  // fib(k)
+    T b = 1;  // fib(k + 1)
+    for (int i = std::bit_width(n) - 1; i >= 1; --i) {
+        T even = a * (2 * b - a);  // fib(2k)
+        T odd = a * a + b * b;  // fib(2k + 1)
+        if ((n >> i) & 1) {
+            a = odd;
+            b = even + odd;
+        } else {
+            a = even;
+            b = odd;
+        }
+    }
+    return (n & 1) ? a * a + b * b : a * (2 * b - a);
+}
+
+/**
+ * @brief Calculates the nth Fibonacci number modulo m in O(log n) steps.
+ *
+ * @param n The index of the Fibonacci number to calculate.
+ * @param m The modulus; any non-zero 64-bit value is accepted.
+ * @return std::uint64_t F(n) mod m.
+ * @throws std::invalid_argument If m is zero.
+ */
+constexpr std::uint64_t fib_mod(std::uint64_t n, std::uint64_t m) {
+    if (m == 0)
+        throw std::invalid_argument("Modulus must be non-zero");
+
+    using wide = unsigned __int128;
+    std::uint64_t a = 0;  // fib(k) mod m
+    std::uint64_t b = 1 % m;  // fib(k + 1) mod m
+    for (int i = std::bit_width(n) - 1; i >= 0; --i) {
+        std::uint64_t twice_b_minus_a = static_cast<std::uint64_t>((wide(2) * b + m - a) % m);
+        std::uint64_t even = static_cast<std::uint64_t>(wide(a) * twice_b_minus_a % m);
+        std::uint64_t odd = static_cast<std::uint64_t>((wide(a) * a % m + wide(b) * b % m) % m);
+        if ((n >> i) & 1) {
+            a = odd;
+            b = static_cast<std::uint64_t>((wide(even) + odd) % m);
+        } else {
+            a = even;
+            b = odd;
+        }
+    }
+    return a;
+}
+
+/**
+ * @brief Converts an unsigned 128-bit integer to its decimal representation.
+ *
+ * @param value The value to be converted.
+ * @return std::string The decimal digits of value.
+ */
+inline std::string to_string(unsigned __int128 value) {
+    if (value == 0)
+        return "0";
+    std::string digits;
+    while (value != 0) {
+        digits += static_cast<char>('0' + static_cast<int>(value % 10));
+        value /= 10;
+    }
+    std::reverse(digits.begin(), digits.end());
+    return digits;
+}
+
+#endif // FIB_FAST_H
@@ -0,0 +1,54 @@
+/**
+ * @file fib_table.cc
+ * @brief A program that prints entries of the compile-time Fibonacci tables.
+ * @details This program prints the size and the last entry of the table for every unsigned integer width, and looks up the 5th Fibonacci number.
+ * @copyright Copyright 2023 Kyungwon Chun
+ * 
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+#include "fib_table.h"
+
+/**
+ * @brief Prints the number of entries and the largest entry of the table for T.
+ * 
+ * @tparam T An unsigned integer type.
+ * @param name The name of T to be printed.
+ */
+template <typename T>
+void print_table_summary(const char* name) {
+    const auto& table = fib_table<T>();
+    std::cout << name << ": " << table.size() << " entries, fib(" << table.size() - 1 << ") = "
+              << to_string(static_cast<unsigned __int128>(table.back())) << std::endl;
+}
+
+/**
+ * @brief The main function that prints a summary of every table and one lookup.
+ * 
+ * @param argc The number of command-line arguments provided.
+ * @param argv An array of strings containing the command-line arguments.
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    print_table_summary<std::uint8_t>("uint8_t");
+    print_table_summary<std::uint16_t>("uint16_t");
+    print_table_summary<std::uint32_t>("uint32_t");
+    print_table_summary<std::uint64_t>("uint64_t");
+    print_table_summary<unsigned __int128>("unsigned __int128");
+    std::cout << "fib(5) = " << fib_lookup(5) << std::endl;
+    return EXIT_SUCCESS;
+}
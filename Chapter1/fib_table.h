@@ -0,0 +1,85 @@
+/**
+ * @file fib_table.h
+ * @brief Compile-time tables of every Fibonacci number that fits in an unsigned integer type.
+ * @details fib_table<T>() returns a constexpr array holding fib(0) through fib(max_fib_index<T>()), so the table
+ * for each integer width has exactly as many entries as that width can represent (14 for uint8_t, 94 for
+ * uint64_t, 187 for unsigned __int128). The tables live in read-only data; a lookup is one array load and
+ * nothing is computed or allocated at startup.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIB_TABLE_H
+#define FIB_TABLE_H
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "fib_fast.h"
+
+/**
+ * @brief Builds the table of all Fibonacci numbers representable in T.
+ *
+ * @tparam T An unsigned integer type.
+ * @return std::array<T, max_fib_index<T>() + 1> The table, indexed by n.
+ */
+template <typename T>
+consteval std::array<T, max_fib_index<T>() + 1> make_fib_table() {
+    std::array<T, max_fib_index<T>() + 1> table{};
+    table[1] = 1;
+    for (std::size_t n = 2; n < table.size(); ++n)
+        table[n] = table[n - 1] + table[n - 2];
+    return table;
+}
+
+/**
+ * @brief The table of all Fibonacci numbers representable in T, evaluated at compile time.
+ *
+ * @tparam T An unsigned integer type.
+ */
+template <typename T>
+inline constexpr std::array<T, max_fib_index<T>() + 1> fib_table_v = make_fib_table<T>();
+
+/**
+ * @brief Returns the compile-time table of all Fibonacci numbers representable in T.
+ *
+ * @tparam T An unsigned integer type.
+ * @return const std::array<T, max_fib_index<T>() + 1>& The table, indexed by n.
+ */
+template <typename T>
+constexpr const std::array<T, max_fib_index<T>() + 1>& fib_table() {
+    return fib_table_v<T>;
+}
+
+/**
+ * @brief Looks up the nth Fibonacci number in the compile-time table.
+ *
+ * @tparam T An unsigned integer type used for the result.
+ * @param n The index of the Fibonacci number.
+ * @return T The nth Fibonacci number.
+ * @throws std::overflow_error If F(n) does not fit in T.
+ */
+template <typename T = std::uint64_t>
+constexpr T fib_lookup(std::uint64_t n) {
+    if (n >= fib_table<T>().size())
+        throw std::overflow_error("fib(" + std::to_string(n) + ") does not fit in the result type");
+    return fib_table<T>()[n];
+}
+
+static_assert(fib_table<std::uint64_t>().size() == 94);
+static_assert(fib_table<std::uint64_t>()[93] == 12200160415121876738ULL);
+
+#endif // FIB_TABLE_H
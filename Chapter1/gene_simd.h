@@ -0,0 +1,343 @@
+/**
+ * @file gene_simd.h
+ * @brief Kernels that convert between ASCII nucleotides and 2-bit packed words, with runtime dispatch.
+ * @details A packed word holds 32 bases, base i in bits 2 (i % 32) and 2 (i % 32) + 1, with the codes A = 00,
+ * C = 01, G = 10 and T = 11 of CompressedGene.
+ *
+ * The scalar kernel handles eight characters in one 64-bit register: ((c >> 1) ^ (c >> 2)) & 3 gives the code
+ * of A, C, G and T, and three shift-and-mask steps gather eight codes into 16 bits. The SSE4.1 and AVX2 kernels
+ * convert 16 and 32 characters per instruction: the low nibbles of A, C, G and T (1, 3, 7 and 4) are distinct,
+ * so one pshufb looks up the codes and a second one the expected characters, and maddubs, madd and a byte
+ * shuffle pack the codes. Every kernel validates its input with a vector compare of the characters against the
+ * looked-up ones and only reports whether some character was invalid, so the loops carry no branches.
+ *
+ * Decoding runs the other way: pshufb copies every byte of a word to the four output bytes that need it, a mask
+ * keeps each byte's own 2-bit field, and, since the field lands in either nibble of the byte, one more pshufb on
+ * the two nibbles or-ed together gives the character.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GENE_SIMD_H
+#define GENE_SIMD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define GENE_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+inline constexpr std::size_t packed_bases_per_word = 32;
+inline constexpr std::uint64_t packed_low_bytes = 0x0101010101010101;
+
+/**
+ * @brief The instruction sets a packing kernel can be built on.
+ */
+enum class GeneKernel {
+    scalar,
+    sse41,
+    avx2,
+};
+
+/**
+ * @brief Returns the name of a kernel.
+ *
+ * @param kernel The kernel.
+ * @return const char* The name.
+ */
+inline const char* to_string(GeneKernel kernel) {
+    switch (kernel) {
+        case GeneKernel::scalar:
+            return "scalar";
+        case GeneKernel::sse41:
+            return "sse4.1";
+        case GeneKernel::avx2:
+            return "avx2";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Returns the ASCII characters of eight 2-bit codes, one per byte.
+ * @details The offsets of C, G and T from A are 2, 6 and 19, which is 2 code + 2 hi + 11 (hi & lo) in the bits
+ * hi and lo of the code; no byte can carry into the next.
+ */
+inline std::uint64_t packed_chars_of_codes(std::uint64_t codes) {
+    const std::uint64_t lo = codes & packed_low_bytes, hi = (codes >> 1) & packed_low_bytes;
+    return 0x41 * packed_low_bytes + 2 * codes + 2 * hi + 11 * (hi & lo);
+}
+
+/**
+ * @brief Returns the 2-bit codes of eight ASCII characters, one per byte.
+ * @details The codes are only meaningful for A, C, G and T; the characters are valid if and only if
+ * packed_chars_of_codes gives them back.
+ *
+ * @param chars Eight characters, the first in the lowest byte.
+ * @return std::uint64_t The codes, one per byte.
+ */
+inline std::uint64_t packed_codes_of_chars(std::uint64_t chars) {
+    return ((chars >> 1) ^ (chars >> 2)) & (3 * packed_low_bytes);
+}
+
+/**
+ * @brief Gathers eight 2-bit codes, one per byte, into 16 bits.
+ */
+inline std::uint64_t packed_gather(std::uint64_t codes) {
+    codes = (codes | codes >> 6) & 0x000F000F000F000F;
+    codes = (codes | codes >> 12) & 0x000000FF000000FF;
+    return (codes | codes >> 24) & 0xFFFF;
+}
+
+/**
+ * @brief Spreads the low 16 bits of 2-bit codes out to one code per byte.
+ */
+inline std::uint64_t packed_spread(std::uint64_t bits) {
+    bits &= 0xFFFF;
+    bits = (bits | bits << 24) & 0x000000FF000000FF;
+    bits = (bits | bits << 12) & 0x000F000F000F000F;
+    return (bits | bits << 6) & (3 * packed_low_bytes);
+}
+
+/**
+ * @brief Encodes 32 characters per word, eight at a time in a 64-bit register.
+ *
+ * @param chars The characters, 32 per word.
+ * @param words The number of words.
+ * @param out The packed words.
+ * @return bool False if a character is not A, C, G or T; the words are then unspecified.
+ */
+inline bool gene_encode_scalar(const char* chars, std::size_t words, std::uint64_t* out) {
+    std::uint64_t invalid = 0;
+    for (std::size_t w = 0; w < words; ++w, chars += packed_bases_per_word) {
+        std::uint64_t word = 0;
+        for (int i = 0; i < 4; ++i) {
+            std::uint64_t block;
+            std::memcpy(&block, chars + 8 * i, 8);
+            const std::uint64_t codes = packed_codes_of_chars(block);
+            invalid |= packed_chars_of_codes(codes) ^ block;
+            word |= packed_gather(codes) << (16 * i);
+        }
+        out[w] = word;
+    }
+    return invalid == 0;
+}
+
+/**
+ * @brief Decodes words into 32 characters each, eight at a time in a 64-bit register.
+ */
+inline void gene_decode_scalar(const std::uint64_t* words, std::size_t count, char* chars) {
+    for (std::size_t w = 0; w < count; ++w, chars += packed_bases_per_word) {
+        for (int i = 0; i < 4; ++i) {
+            const std::uint64_t block = packed_chars_of_codes(packed_spread(words[w] >> (16 * i)));
+            std::memcpy(chars + 8 * i, &block, 8);
+        }
+    }
+}
+
+#ifdef GENE_SIMD_X86
+
+/**
+ * @brief Encodes 32 characters per word, sixteen per instruction with SSE4.1.
+ */
+__attribute__((target("sse4.1"))) inline bool gene_encode_sse41(const char* chars, std::size_t words,
+                                                                std::uint64_t* out) {
+    const __m128i code_table = _mm_setr_epi8(0, 0, 0, 1, 3, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0);
+    // Every entry but those of A, C, G and T has a low nibble other than its index, so no other character matches.
+    const __m128i char_table = _mm_setr_epi8(-1, 'A', 0, 'C', 'T', 0, 0, 'G', 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    const __m128i pair_weights = _mm_set1_epi16(0x0401);       // code0 + 4 code1 per 16 bits
+    const __m128i quad_weights = _mm_set1_epi32(0x00100001);  // pair0 + 16 pair1 per 32 bits
+    const __m128i gather = _mm_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    __m128i invalid = _mm_setzero_si128();
+    for (std::size_t w = 0; w < words; ++w) {
+        std::uint64_t word = 0;
+        for (int half = 0; half < 2; ++half) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars + 32 * w + 16 * half));
+            const __m128i index = _mm_and_si128(v, nibble);
+            invalid = _mm_or_si128(invalid, _mm_xor_si128(_mm_shuffle_epi8(char_table, index), v));
+            const __m128i codes = _mm_shuffle_epi8(code_table, index);
+            const __m128i packed = _mm_madd_epi16(_mm_maddubs_epi16(codes, pair_weights), quad_weights);
+            const auto bits = static_cast<std::uint32_t>(_mm_cvtsi128_si32(_mm_shuffle_epi8(packed, gather)));
+            word |= std::uint64_t(bits) << (32 * half);
+        }
+        out[w] = word;
+    }
+    return _mm_testz_si128(invalid, invalid);
+}
+
+/**
+ * @brief Decodes words into 32 characters each, sixteen per instruction with SSE4.1.
+ */
+__attribute__((target("sse4.1"))) inline void gene_decode_sse41(const std::uint64_t* words, std::size_t count,
+                                                                char* chars) {
+    const __m128i spread = _mm_setr_epi8(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3);
+    const __m128i fields = _mm_set1_epi32(static_cast<int>(0xC0300C03));
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    const __m128i char_table = _mm_setr_epi8('A', 'C', 'G', 'T', 'C', 0, 0, 0, 'G', 0, 0, 0, 'T', 0, 0, 0);
+    for (std::size_t w = 0; w < count; ++w) {
+        for (int half = 0; half < 2; ++half) {
+            const __m128i x = _mm_cvtsi32_si128(static_cast<int>(words[w] >> (32 * half)));
+            const __m128i y = _mm_and_si128(_mm_shuffle_epi8(x, spread), fields);
+            const __m128i index = _mm_or_si128(_mm_and_si128(y, nibble), _mm_and_si128(_mm_srli_epi16(y, 4), nibble));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(chars + 32 * w + 16 * half),
+                             _mm_shuffle_epi8(char_table, index));
+        }
+    }
+}
+
+/**
+ * @brief Encodes 32 characters per word, one word per instruction with AVX2.
+ */
+__attribute__((target("avx2"))) inline bool gene_encode_avx2(const char* chars, std::size_t words,
+                                                             std::uint64_t* out) {
+    const __m256i code_table = _mm256_setr_epi8(0, 0, 0, 1, 3, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 3, 0,
+                                                0, 2, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i char_table = _mm256_setr_epi8(-1, 'A', 0, 'C', 'T', 0, 0, 'G', 0, 0, 0, 0, 0, 0, 0, 0, -1, 'A',
+                                                0, 'C', 'T', 0, 0, 'G', 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i pair_weights = _mm256_set1_epi16(0x0401);
+    const __m256i quad_weights = _mm256_set1_epi32(0x00100001);
+    const __m256i gather = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 4, 8,
+                                            12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m256i lanes = _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0);
+    __m256i invalid = _mm256_setzero_si256();
+    for (std::size_t w = 0; w < words; ++w) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chars + 32 * w));
+        const __m256i index = _mm256_and_si256(v, nibble);
+        invalid = _mm256_or_si256(invalid, _mm256_xor_si256(_mm256_shuffle_epi8(char_table, index), v));
+        const __m256i codes = _mm256_shuffle_epi8(code_table, index);
+        const __m256i packed = _mm256_madd_epi16(_mm256_maddubs_epi16(codes, pair_weights), quad_weights);
+        const __m256i bytes = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(packed, gather), lanes);
+        out[w] = static_cast<std::uint64_t>(_mm_cvtsi128_si64(_mm256_castsi256_si128(bytes)));
+    }
+    return _mm256_testz_si256(invalid, invalid);
+}
+
+/**
+ * @brief Decodes words into 32 characters each, one word per instruction with AVX2.
+ */
+__attribute__((target("avx2"))) inline void gene_decode_avx2(const std::uint64_t* words, std::size_t count,
+                                                             char* chars) {
+    const __m256i spread = _mm256_setr_epi8(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5,
+                                            6, 6, 6, 6, 7, 7, 7, 7);
+    const __m256i fields = _mm256_set1_epi32(static_cast<int>(0xC0300C03));
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i char_table = _mm256_setr_epi8('A', 'C', 'G', 'T', 'C', 0, 0, 0, 'G', 0, 0, 0, 'T', 0, 0, 0, 'A',
+                                                'C', 'G', 'T', 'C', 0, 0, 0, 'G', 0, 0, 0, 'T', 0, 0, 0);
+    for (std::size_t w = 0; w < count; ++w) {
+        const __m256i x = _mm256_set1_epi64x(static_cast<long long>(words[w]));
+        const __m256i y = _mm256_and_si256(_mm256_shuffle_epi8(x, spread), fields);
+        const __m256i index =
+            _mm256_or_si256(_mm256_and_si256(y, nibble), _mm256_and_si256(_mm256_srli_epi16(y, 4), nibble));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(chars + 32 * w), _mm256_shuffle_epi8(char_table, index));
+    }
+}
+
+#endif // GENE_SIMD_X86
+
+/**
+ * @brief Returns whether the running CPU can execute a kernel.
+ *
+ * @param kernel The kernel.
+ * @return bool True if the kernel is supported.
+ */
+inline bool gene_kernel_supported(GeneKernel kernel) {
+    switch (kernel) {
+        case GeneKernel::scalar:
+            return true;
+#ifdef GENE_SIMD_X86
+        case GeneKernel::sse41:
+            return __builtin_cpu_supports("sse4.1");
+        case GeneKernel::avx2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Returns the fastest kernel the running CPU supports, detected once.
+ */
+inline GeneKernel best_gene_kernel() {
+    static const GeneKernel best = [] {
+        for (GeneKernel kernel : {GeneKernel::avx2, GeneKernel::sse41}) {
+            if (gene_kernel_supported(kernel))
+                return kernel;
+        }
+        return GeneKernel::scalar;
+    }();
+    return best;
+}
+
+/**
+ * @brief Encodes 32 characters per word with a kernel.
+ *
+ * @param chars The characters, 32 per word.
+ * @param words The number of words.
+ * @param out The packed words.
+ * @param kernel The kernel.
+ * @return bool False if a character is not A, C, G or T; the words are then unspecified.
+ * @throws std::invalid_argument If the CPU does not support the kernel.
+ */
+inline bool gene_encode(const char* chars, std::size_t words, std::uint64_t* out,
+                        GeneKernel kernel = best_gene_kernel()) {
+    if (!gene_kernel_supported(kernel))
+        throw std::invalid_argument(std::string("Unsupported kernel: ") + to_string(kernel));
+    switch (kernel) {
+#ifdef GENE_SIMD_X86
+        case GeneKernel::sse41:
+            return gene_encode_sse41(chars, words, out);
+        case GeneKernel::avx2:
+            return gene_encode_avx2(chars, words, out);
+#endif
+        default:
+            return gene_encode_scalar(chars, words, out);
+    }
+}
+
+/**
+ * @brief Decodes words into 32 characters each with a kernel.
+ *
+ * @param words The packed words.
+ * @param count The number of words.
+ * @param chars The characters, 32 per word.
+ * @param kernel The kernel.
+ * @throws std::invalid_argument If the CPU does not support the kernel.
+ */
+inline void gene_decode(const std::uint64_t* words, std::size_t count, char* chars,
+                        GeneKernel kernel = best_gene_kernel()) {
+    if (!gene_kernel_supported(kernel))
+        throw std::invalid_argument(std::string("Unsupported kernel: ") + to_string(kernel));
+    switch (kernel) {
+#ifdef GENE_SIMD_X86
+        case GeneKernel::sse41:
+            gene_decode_sse41(words, count, chars);
+            break;
+        case GeneKernel::avx2:
+            gene_decode_avx2(words, count, chars);
+            break;
+#endif
+        default:
+            gene_decode_scalar(words, count, chars);
+            break;
+    }
+}
+
+#endif // GENE_SIMD_H
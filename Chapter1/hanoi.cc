@@ -19,45 +19,8 @@
 
 #include <cstdlib>
 #include <iostream>
-#include <stack>
 
-/**
- * Solves the Tower of Hanoi problem recursively.
- * Moves the top n disks from the begin stack to the end stack using the temp stack as a buffer.
- * @param begin The stack where the disks start.
- * @param end The stack where the disks should end up.
- * @param temp The stack used as a buffer.
- * @param n The number of disks to move.
- */
-void hanoi(std::stack<int>& begin, std::stack<int>& end, std::stack<int>& temp, int n) {
-    if (n == 1) {
-        end.push(begin.top());
-        begin.pop();
-    } else {
-        hanoi(begin, temp, end, n - 1);
-        end.push(begin.top());
-        begin.pop();
-        hanoi(temp, end, begin, n - 1);
-    }
-}
-
-/**
- * @brief Prints the contents of a stack of integers.
- * 
- * @param s The stack to be printed.
- */
-void print_stack(const std::stack<int>& s) {
-    std::stack<int> temp = s;
-    std::cout << "[";
-    while (!temp.empty()) {
-        std::cout << temp.top();
-        temp.pop();
-        if (!temp.empty()) {
-            std::cout << " ";
-        }
-    }
-    std::cout << "]" << std::endl;
-}
+#include "hanoi.h"
 
 /**
  * @brief The main function that solves the Tower of Hanoi problem.
@@ -68,18 +31,12 @@ void print_stack(const std::stack<int>& s) {
  */
 int main(int argc, char* argv[]) {
     int num_discs = 3;
-    std::stack<int> tower_a;
-    std::stack<int> tower_b;
-    std::stack<int> tower_c;
+    HanoiTowers towers(num_discs, 0);
 
-    for (int i = 1; i <= num_discs; ++i) {
-        tower_a.push(i);
+    hanoi(towers, 0, 2, 1, num_discs);
+    for (int peg = 0; peg < 3; ++peg) {
+        towers.print(std::cout, peg);
     }
-    
-    hanoi(tower_a, tower_c, tower_b, num_discs);
-    print_stack(tower_a);
-    print_stack(tower_b);
-    print_stack(tower_c);
 
     return EXIT_SUCCESS;
 }
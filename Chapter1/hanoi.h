@@ -0,0 +1,345 @@
+/**
+ * @file hanoi.h
+ * @brief Solvers for the Tower of Hanoi problem.
+ * @details The Tower of Hanoi is a mathematical puzzle where you have three rods and n disks of different sizes.
+ * The pegs are held as three 64-bit disk masks. Besides the recursive solver, the moves can be generated one
+ * after another without recursion or state: move k (counting from 1) takes disk countr_zero(k) + 1 from peg
+ * (k & (k - 1)) % 3 to peg ((k | (k - 1)) + 1) % 3, which carries the tower from peg 0 to peg 2 for odd n and to
+ * peg 1 for even n.
+ * @copyright Copyright 2023 Kyungwon Chun
+ * 
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HANOI_H
+#define HANOI_H
+
+#include <bit>
+#include <cstdint>
+#include <iostream>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * @brief The largest number of disks the iterative solver supports; move numbers must fit in 64 bits.
+ */
+inline constexpr int max_hanoi_disks = 63;
+
+/**
+ * @brief A single move of the smallest disk on one peg to another peg.
+ */
+struct HanoiMove {
+    int disk;  // 1 is the smallest disk
+    int from;
+    int to;
+};
+
+/**
+ * @brief The state of the three pegs as disk masks; bit d - 1 of a mask is set if disk d is on the peg.
+ * @details The top disk of a peg is its lowest set bit, so moves and legality checks are a few bit operations.
+ */
+class HanoiTowers {
+public:
+    /**
+     * @brief Stacks n disks on one peg.
+     *
+     * @param n The number of disks, at most max_hanoi_disks.
+     * @param peg The peg that holds all disks.
+     * @throws std::invalid_argument If n or the peg is out of range.
+     */
+    explicit HanoiTowers(int n, int peg = 0) : _disks(n) {
+        if (n < 0 || n > max_hanoi_disks)
+            throw std::invalid_argument("The number of disks must be between 0 and 63");
+        if (peg < 0 || peg > 2)
+            throw std::invalid_argument("The peg must be 0, 1 or 2");
+        _pegs[peg] = (std::uint64_t(1) << n) - 1;
+    }
+
+    /**
+     * @brief Builds a state from the masks of the three pegs.
+     *
+     * @param n The number of disks, at most max_hanoi_disks.
+     * @param masks The disk masks of pegs 0, 1 and 2.
+     * @throws std::invalid_argument If n is out of range or the masks do not hold each of the n disks once.
+     */
+    HanoiTowers(int n, const std::uint64_t (&masks)[3]) : _disks(n) {
+        if (n < 0 || n > max_hanoi_disks)
+            throw std::invalid_argument("The number of disks must be between 0 and 63");
+        if ((masks[0] & masks[1]) != 0 || (masks[0] & masks[2]) != 0 || (masks[1] & masks[2]) != 0 ||
+            (masks[0] | masks[1] | masks[2]) != (std::uint64_t(1) << n) - 1)
+            throw std::invalid_argument("Every disk must be on exactly one peg");
+        for (int peg = 0; peg < 3; ++peg)
+            _pegs[peg] = masks[peg];
+    }
+
+    /**
+     * @brief Returns the number of disks.
+     */
+    int disks() const {
+        return _disks;
+    }
+
+    /**
+     * @brief Returns the mask of the disks on a peg.
+     */
+    std::uint64_t mask(int peg) const {
+        return _pegs[peg];
+    }
+
+    /**
+     * @brief Returns the top disk of a peg, or 0 if the peg is empty.
+     */
+    int top(int peg) const {
+        return _pegs[peg] == 0 ? 0 : std::countr_zero(_pegs[peg]) + 1;
+    }
+
+    /**
+     * @brief Returns whether the top disk of peg from may go onto peg to, i.e. peg to holds no smaller disk.
+     */
+    bool can_move(int from, int to) const {
+        std::uint64_t disk = _pegs[from] & -_pegs[from];
+        return disk != 0 && (_pegs[to] & (disk - 1)) == 0;
+    }
+
+    /**
+     * @brief Moves the top disk of peg from to peg to without checking the move.
+     */
+    void move(int from, int to) {
+        std::uint64_t disk = _pegs[from] & -_pegs[from];
+        _pegs[from] ^= disk;
+        _pegs[to] |= disk;
+    }
+
+    /**
+     * @brief Applies a move whose disk is known, without checking it.
+     */
+    void apply(const HanoiMove& move) {
+        std::uint64_t disk = std::uint64_t(1) << (move.disk - 1);
+        _pegs[move.from] ^= disk;
+        _pegs[move.to] ^= disk;
+    }
+
+    /**
+     * @brief Prints the disks of a peg from the top down.
+     *
+     * @param out The stream to print to.
+     * @param peg The peg.
+     */
+    void print(std::ostream& out, int peg) const {
+        out << "[";
+        for (std::uint64_t rest = _pegs[peg]; rest != 0; rest &= rest - 1) {
+            out << std::countr_zero(rest) + 1;
+            if ((rest & (rest - 1)) != 0)
+                out << " ";
+        }
+        out << "]" << std::endl;
+    }
+
+    bool operator==(const HanoiTowers& other) const = default;
+
+private:
+    int _disks;
+    std::uint64_t _pegs[3] = {};
+};
+
+/**
+ * Solves the Tower of Hanoi problem recursively.
+ * Moves the top n disks from the begin peg to the end peg using the temp peg as a buffer.
+ * @param towers The state of the pegs.
+ * @param begin The peg where the disks start.
+ * @param end The peg where the disks should end up.
+ * @param temp The peg used as a buffer.
+ * @param n The number of disks to move.
+ */
+inline void hanoi(HanoiTowers& towers, int begin, int end, int temp, int n) {
+    if (n == 0)
+        return;
+    hanoi(towers, begin, temp, end, n - 1);
+    towers.move(begin, end);
+    hanoi(towers, temp, end, begin, n - 1);
+}
+
+/**
+ * @brief Returns the number of moves that solve n disks, 2^n - 1.
+ *
+ * @param n The number of disks, at most max_hanoi_disks.
+ * @return std::uint64_t The number of moves.
+ * @throws std::invalid_argument If n is negative or above max_hanoi_disks.
+ */
+inline std::uint64_t hanoi_move_count(int n) {
+    if (n < 0 || n > max_hanoi_disks)
+        throw std::invalid_argument("The number of disks must be between 0 and 63");
+    return (std::uint64_t(1) << n) - 1;
+}
+
+/**
+ * @brief The pegs of the moves of one solution, by k mod 3 and the parity of countr_zero(k).
+ * @details With t = countr_zero(k), k & (k - 1) = k - 2^t and (k | (k - 1)) + 1 = k + 2^t, and 2^t mod 3 is 1
+ * for even t and 2 for odd t, so both pegs of move k follow from k mod 3 and the parity of t.
+ */
+class HanoiPegTable {
+public:
+    /**
+     * @brief Prepares the table for n disks that go from peg from to peg to.
+     *
+     * @throws std::invalid_argument If the pegs are not two different pegs of 0, 1 and 2.
+     */
+    HanoiPegTable(int n, int from, int to) {
+        if (from < 0 || from > 2 || to < 0 || to > 2 || from == to)
+            throw std::invalid_argument("The pegs must be two different pegs of 0, 1 and 2");
+        // The formula solves 0 -> 2 for odd n and 0 -> 1 for even n; relabel its pegs as from, to and the spare one.
+        const int spare = 3 - from - to;
+        const int pegs[3] = {from, n % 2 == 1 ? spare : to, n % 2 == 1 ? to : spare};
+        for (int r = 0; r < 3; ++r) {
+            for (int odd = 0; odd < 2; ++odd) {
+                _sources[r][odd] = pegs[(r + 2 - odd) % 3];  // k - 2^t
+                _targets[r][odd] = pegs[(r + 1 + odd) % 3];  // k + 2^t
+            }
+        }
+    }
+
+    /**
+     * @brief Returns move k, given k mod 3.
+     */
+    HanoiMove move(std::uint64_t k, int residue) const {
+        const int t = std::countr_zero(k);
+        return {t + 1, _sources[residue][t & 1], _targets[residue][t & 1]};
+    }
+
+private:
+    int _sources[3][2];
+    int _targets[3][2];
+};
+
+/**
+ * @brief Returns move k of the solution that carries n disks from peg from to peg to.
+ *
+ * @param n The number of disks.
+ * @param k The number of the move, from 1 to 2^n - 1.
+ * @param from The peg where the disks start.
+ * @param to The peg where the disks should end up; it differs from from.
+ * @return HanoiMove The move.
+ * @throws std::invalid_argument If the pegs are not two different pegs of 0, 1 and 2.
+ */
+inline HanoiMove hanoi_move(int n, std::uint64_t k, int from = 0, int to = 2) {
+    return HanoiPegTable(n, from, to).move(k, static_cast<int>(k % 3));
+}
+
+/**
+ * @brief Generates the moves first, first + 1, ..., last of a solution without recursion or allocation.
+ * @details The loop runs over triples of moves, whose residues mod 3 are known, so it needs no division.
+ *
+ * @param n The number of disks, at most max_hanoi_disks.
+ * @param first The number of the first move, at least 1.
+ * @param last The number of the last move, at most 2^n - 1.
+ * @param emit The callback, called as emit(HanoiMove) for every move in order.
+ * @param from The peg where the disks start.
+ * @param to The peg where the disks should end up; it differs from from.
+ * @throws std::invalid_argument If n is out of range or the pegs are not two different pegs of 0, 1 and 2.
+ * @throws std::out_of_range If the moves are not within 1 and 2^n - 1.
+ */
+template <typename Emit>
+void hanoi_iterative(int n, std::uint64_t first, std::uint64_t last, Emit&& emit, int from = 0, int to = 2) {
+    const HanoiPegTable table(n, from, to);
+    if (first == 0 || (first <= last && last > hanoi_move_count(n)))
+        throw std::out_of_range("Moves are numbered from 1 to 2^n - 1");
+
+    std::uint64_t k = first;
+    for (; k <= last && k % 3 != 1; ++k)
+        emit(table.move(k, static_cast<int>(k % 3)));
+    for (; k + 2 <= last; k += 3) {
+        emit(table.move(k, 1));
+        emit(table.move(k + 1, 2));
+        emit(table.move(k + 2, 0));
+    }
+    for (int residue = 1; k <= last; ++k, ++residue)
+        emit(table.move(k, residue));
+}
+
+/**
+ * @brief Solves the Tower of Hanoi problem without recursion or allocation, passing each move to a callback.
+ *
+ * @param n The number of disks, at most max_hanoi_disks.
+ * @param emit The callback, called as emit(HanoiMove) for moves 1, 2, ..., 2^n - 1 in order.
+ * @param from The peg where the disks start.
+ * @param to The peg where the disks should end up; it differs from from.
+ * @throws std::invalid_argument If n is out of range or the pegs are not two different pegs of 0, 1 and 2.
+ */
+template <typename Emit>
+void hanoi_iterative(int n, Emit&& emit, int from = 0, int to = 2) {
+    hanoi_iterative(n, 1, hanoi_move_count(n), std::forward<Emit>(emit), from, to);
+}
+
+/**
+ * @brief Solves the Tower of Hanoi problem iteratively on a state whose disks are all on peg from.
+ *
+ * @param towers The state of the pegs.
+ * @param from The peg that holds all disks.
+ * @param to The peg where the disks should end up; it differs from from.
+ * @throws std::invalid_argument If the pegs are not two different pegs of 0, 1 and 2.
+ */
+inline void hanoi_iterative(HanoiTowers& towers, int from, int to) {
+    hanoi_iterative(towers.disks(), [&towers](const HanoiMove& move) { towers.apply(move); }, from, to);
+}
+
+/**
+ * @brief Returns the state after the first k moves of a solution in O(n), without simulating the moves.
+ * @details The largest disk moves once, at move 2^(n - 1). Before it the smaller disks are on their way from
+ * the source to the spare peg, after it from the spare to the target peg, so each disk, from the largest down,
+ * settles its peg and the sub-problem of the disks above it.
+ *
+ * @param n The number of disks, at most max_hanoi_disks.
+ * @param k The number of moves made, at most 2^n - 1.
+ * @param from The peg where the disks start.
+ * @param to The peg where the disks should end up; it differs from from.
+ * @return HanoiTowers The state.
+ * @throws std::invalid_argument If n is out of range or the pegs are not two different pegs of 0, 1 and 2.
+ * @throws std::out_of_range If k exceeds the number of moves.
+ */
+inline HanoiTowers hanoi_state(int n, std::uint64_t k, int from = 0, int to = 2) {
+    if (from < 0 || from > 2 || to < 0 || to > 2 || from == to)
+        throw std::invalid_argument("The pegs must be two different pegs of 0, 1 and 2");
+    if (k > hanoi_move_count(n))
+        throw std::out_of_range("Moves are numbered from 1 to 2^n - 1");
+
+    std::uint64_t masks[3] = {};
+    int spare = 3 - from - to;
+    for (int disk = n; disk >= 1; --disk) {
+        const std::uint64_t half = std::uint64_t(1) << (disk - 1);
+        if (k < half) {
+            masks[from] |= half;
+            std::swap(to, spare);
+        } else {
+            masks[to] |= half;
+            k -= half;
+            std::swap(from, spare);
+        }
+    }
+    return HanoiTowers(n, masks);
+}
+
+/**
+ * @brief Returns a lazy range over the moves that carry n disks from peg 0 to peg 2.
+ *
+ * @param n The number of disks, at most max_hanoi_disks.
+ * @return auto A random-access range of HanoiMove.
+ * @throws std::invalid_argument If n is out of range.
+ */
+inline auto hanoi_moves(int n) {
+    const HanoiPegTable table(n, 0, 2);
+    return std::views::iota(std::uint64_t(1), hanoi_move_count(n) + 1) |
+           std::views::transform([table](std::uint64_t k) { return table.move(k, static_cast<int>(k % 3)); });
+}
+
+#endif // HANOI_H
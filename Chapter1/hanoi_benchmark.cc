@@ -0,0 +1,104 @@
+/**
+ * @file hanoi_benchmark.cc
+ * @brief A program that compares the recursive Tower of Hanoi solver with the iterative move generator.
+ * @details Usage: hanoi_benchmark [max_disks]. For 10, 15, 20, ... disks up to max_disks (25 by default) the
+ * program prints the moves per second of the recursive and the iterative solver, both on the bitmask towers,
+ * and of the lazy move range alone. Before that it replays the iterative moves for small towers to check that
+ * every move is legal and the tower arrives on the target peg.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "benchmark.h"
+#include "hanoi.h"
+
+/**
+ * @brief Replays the iterative moves on a fresh state and checks them.
+ *
+ * @param n The number of disks.
+ * @param from The peg where the disks start.
+ * @param to The peg where the disks should end up.
+ * @return bool True if every move takes the named disk onto a larger one and all disks end on peg to.
+ */
+bool replay(int n, int from, int to) {
+    HanoiTowers towers(n, from);
+    bool legal = true;
+    hanoi_iterative(
+        n,
+        [&](HanoiMove move) {
+            legal = legal && towers.top(move.from) == move.disk && towers.can_move(move.from, move.to);
+            towers.move(move.from, move.to);
+        },
+        from, to);
+    return legal && towers.mask(to) == HanoiTowers(n, to).mask(to);
+}
+
+/**
+ * @brief The main function that times the solvers for several tower sizes.
+ *
+ * @param argc The number of command-line arguments provided.
+ * @param argv An array of strings containing the command-line arguments.
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    int max_disks = argc > 1 ? std::stoi(argv[1]) : 25;
+
+    bool verified = true;
+    for (int n = 1; n <= 10; ++n) {
+        for (int from = 0; from < 3; ++from) {
+            for (int to = 0; to < 3; ++to) {
+                if (from != to)
+                    verified = verified && replay(n, from, to);
+            }
+        }
+    }
+    std::cout << "iterative moves replayed on the towers: " << (verified ? "legal" : "ILLEGAL") << std::endl;
+
+    std::cout << std::setw(6) << "disks" << std::setw(14) << "moves" << std::setw(16) << "recursive M/s"
+              << std::setw(16) << "iterative M/s" << std::setw(16) << "range M/s" << std::endl;
+    for (int n = 10; n <= max_disks; n += 5) {
+        const std::uint64_t moves = hanoi_move_count(n);
+
+        HanoiTowers recursive_towers(n, 0);
+        Stopwatch watch;
+        hanoi(recursive_towers, 0, 2, 1, n);
+        double recursive = watch.seconds();
+        do_not_optimize(recursive_towers.mask(2));
+
+        HanoiTowers iterative_towers(n, 0);
+        watch.reset();
+        hanoi_iterative(iterative_towers, 0, 2);
+        double iterative = watch.seconds();
+        do_not_optimize(iterative_towers.mask(2));
+
+        std::uint64_t checksum = 0;
+        watch.reset();
+        for (HanoiMove move : hanoi_moves(n))
+            checksum += move.disk + 3 * move.from + move.to;
+        double range = watch.seconds();
+        do_not_optimize(checksum);
+
+        std::cout << std::setw(6) << n << std::setw(14) << moves << std::fixed << std::setprecision(1)
+                  << std::setw(16) << moves / recursive / 1e6 << std::setw(16) << moves / iterative / 1e6
+                  << std::setw(16) << moves / range / 1e6 << std::defaultfloat << std::endl;
+    }
+
+    return verified ? EXIT_SUCCESS : EXIT_FAILURE;
+}
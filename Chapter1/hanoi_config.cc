@@ -0,0 +1,153 @@
+/**
+ * @file hanoi_config.cc
+ * @brief A program that verifies and times the shortest Hanoi solutions from arbitrary configurations.
+ * @details Usage: hanoi_config [max_bfs_disks] [window]. For every n up to max_bfs_disks (10 by default) the
+ * program compares hanoi_distance on all 3^n configurations and all three targets with a breadth-first search,
+ * and replays every solution on bitmask pegs. Then it times hanoi_distance on random configurations of 10 to 60
+ * disks, and the move generator on a window of at most window moves (2^26 by default) from the middle of each
+ * solution.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "hanoi_config.h"
+
+/**
+ * @brief Returns a random legal configuration of n disks.
+ */
+HanoiTowers random_config(int n, std::mt19937_64& rng) {
+    std::uint64_t masks[3] = {};
+    for (int disk = 1; disk <= n; ++disk)
+        masks[rng() % 3] |= std::uint64_t(1) << (disk - 1);
+    return HanoiTowers(n, masks);
+}
+
+/**
+ * @brief Checks every configuration of n disks against the breadth-first search and replays its solution.
+ *
+ * @param n The number of disks.
+ * @return bool True if all counts match and every solution is legal, as long as its count, and ends on the target.
+ */
+bool verify(int n) {
+    std::uint64_t states = 1;
+    for (int i = 0; i < n; ++i)
+        states *= 3;
+    for (int to = 0; to < 3; ++to) {
+        const std::vector<std::uint32_t> distances = hanoi_bfs_distances(n, to);
+        for (std::uint64_t index = 0; index < states; ++index) {
+            const HanoiTowers start = hanoi_config_from_index(n, index);
+            const std::uint64_t distance = hanoi_distance(start, to);
+            if (distance != distances[index])
+                return false;
+            HanoiTowers towers = start;
+            std::uint64_t count = 0;
+            bool legal = true;
+            hanoi_solve_from(
+                start,
+                [&](const HanoiMove& move) {
+                    legal = legal && towers.top(move.from) == move.disk && towers.can_move(move.from, move.to);
+                    towers.apply(move);
+                    ++count;
+                },
+                to);
+            if (!legal || count != distance || !(towers == HanoiTowers(n, to)))
+                return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Checks that windows of a solution match the same moves of the whole solution.
+ */
+bool verify_windows(int n, std::mt19937_64& rng) {
+    const HanoiTowers start = random_config(n, rng);
+    std::vector<HanoiMove> moves;
+    hanoi_solve_from(start, [&](const HanoiMove& move) { moves.push_back(move); });
+    for (int trial = 0; trial < 100 && !moves.empty(); ++trial) {
+        std::uint64_t first = 1 + rng() % moves.size();
+        std::uint64_t last = first + rng() % (moves.size() - first + 1);
+        std::uint64_t k = first;
+        bool same = true;
+        hanoi_solve_from(start, first, last, [&](const HanoiMove& move) {
+            const HanoiMove& expected = moves[k++ - 1];
+            same = same && move.disk == expected.disk && move.from == expected.from && move.to == expected.to;
+        });
+        if (!same || k != last + 1)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief The main function that verifies and times the solver.
+ *
+ * @param argc The number of command-line arguments provided.
+ * @param argv An array of strings containing the command-line arguments.
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    int max_bfs_disks = argc > 1 ? std::stoi(argv[1]) : 10;
+    std::uint64_t window = argc > 2 ? std::stoull(argv[2]) : std::uint64_t(1) << 26;
+
+    bool valid = true;
+    for (int n = 1; n <= max_bfs_disks; ++n)
+        valid = verify(n) && valid;
+    std::mt19937_64 rng(2023);
+    for (int n = 1; n <= 16; ++n)
+        valid = verify_windows(n, rng) && valid;
+    std::cout << "all configurations of 1 to " << max_bfs_disks << " disks: " << (valid ? "ok" : "FAILED")
+              << std::endl;
+
+    constexpr int configs = 1 << 16;
+    std::cout << std::setw(6) << "disks" << std::setw(14) << "ns/distance" << std::setw(14) << "window"
+              << std::setw(14) << "Mmoves/s" << std::endl;
+    for (int n = 10; n <= 60; n += 10) {
+        std::vector<HanoiTowers> starts;
+        for (int i = 0; i < configs; ++i)
+            starts.push_back(random_config(n, rng));
+
+        Stopwatch watch;
+        std::uint64_t total = 0;
+        for (const HanoiTowers& start : starts)
+            total += hanoi_distance(start);
+        double distance_seconds = watch.seconds();
+        do_not_optimize(total);
+
+        const std::uint64_t distance = hanoi_distance(starts[0]);
+        const std::uint64_t first = distance / 2 + 1, last = std::min(distance, first + window - 1);
+        std::uint64_t checksum = 0;
+        watch.reset();
+        hanoi_solve_from(starts[0], first, last,
+                         [&](const HanoiMove& move) { checksum += move.disk * 3 + move.to; });
+        double stream_seconds = watch.seconds();
+        do_not_optimize(checksum);
+
+        std::cout << std::setw(6) << n << std::fixed << std::setprecision(1) << std::setw(14)
+                  << 1e9 * distance_seconds / configs << std::setw(14) << last - first + 1 << std::setw(14)
+                  << (last - first + 1) / stream_seconds / 1e6 << std::defaultfloat << std::endl;
+    }
+
+    return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
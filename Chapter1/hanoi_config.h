@@ -0,0 +1,205 @@
+/**
+ * @file hanoi_config.h
+ * @brief Shortest solutions of the Tower of Hanoi from any legal configuration of the three pegs.
+ * @details To gather all disks on a target peg, the largest disk d that is not yet there has to move once from
+ * its peg s to the target, with disks 1 .. d - 1 waiting on the third peg, which becomes the target of the
+ * smaller disks. Walking the disks from the largest down gives the segments of the optimal solution: disk d
+ * moves, then the tower of disks 1 .. d - 1 follows it in 2^(d - 1) - 1 moves. The optimal count is the sum of
+ * 2^(d - 1) over the disks that move, found in O(n); the segments run from the smallest disk up.
+ *
+ * A breadth-first search over all 3^n configurations verifies the counts for small n.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HANOI_CONFIG_H
+#define HANOI_CONFIG_H
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "hanoi.h"
+
+/**
+ * @brief Returns the peg that holds a disk.
+ */
+inline int hanoi_peg_of(const HanoiTowers& towers, int disk) {
+    return static_cast<int>(((towers.mask(1) >> (disk - 1)) & 1) | (((towers.mask(2) >> (disk - 1)) & 1) << 1));
+}
+
+/**
+ * @brief One segment of an optimal solution: a disk moves, then the tower of all smaller disks follows it.
+ */
+struct HanoiSegment {
+    int disk;
+    int from;
+    int to;
+    int spare;  // the peg the smaller disks wait on
+};
+
+/**
+ * @brief Finds the segments of the optimal solution that gathers all disks on a peg.
+ *
+ * @param towers The configuration.
+ * @param to The target peg.
+ * @param segments Receives the segments in the order they run, smallest disk first.
+ * @return int The number of segments.
+ * @throws std::invalid_argument If the target is not 0, 1 or 2.
+ */
+inline int hanoi_segments(const HanoiTowers& towers, int to, HanoiSegment (&segments)[max_hanoi_disks]) {
+    if (to < 0 || to > 2)
+        throw std::invalid_argument("The target must be peg 0, 1 or 2");
+    int count = 0;
+    for (int disk = towers.disks(); disk >= 1; --disk) {
+        const int from = hanoi_peg_of(towers, disk);
+        if (from == to)
+            continue;
+        const int spare = 3 - from - to;
+        segments[count++] = {disk, from, to, spare};
+        to = spare;
+    }
+    for (int i = 0, j = count - 1; i < j; ++i, --j)
+        std::swap(segments[i], segments[j]);
+    return count;
+}
+
+/**
+ * @brief Returns the length of the shortest solution that gathers all disks on a peg, in O(n).
+ *
+ * @param towers The configuration.
+ * @param to The target peg.
+ * @return std::uint64_t The number of moves.
+ * @throws std::invalid_argument If the target is not 0, 1 or 2.
+ */
+inline std::uint64_t hanoi_distance(const HanoiTowers& towers, int to = 2) {
+    if (to < 0 || to > 2)
+        throw std::invalid_argument("The target must be peg 0, 1 or 2");
+    std::uint64_t moves = 0;
+    for (int disk = towers.disks(); disk >= 1; --disk) {  // branch-free, as the pegs of the disks are arbitrary
+        const int from = hanoi_peg_of(towers, disk);
+        const bool moved = from != to;
+        moves |= std::uint64_t(moved) << (disk - 1);
+        to = moved ? 3 - from - to : to;
+    }
+    return moves;
+}
+
+/**
+ * @brief Generates the moves first to last of the shortest solution from a configuration, without allocation.
+ * @details Whole segments before first are skipped, so a window anywhere in a long solution costs O(n) to reach.
+ *
+ * @param towers The configuration.
+ * @param first The number of the first move, at least 1.
+ * @param last The number of the last move, at most hanoi_distance(towers, to).
+ * @param emit The callback, called as emit(HanoiMove) for every move in order.
+ * @param to The target peg.
+ * @throws std::invalid_argument If the target is not 0, 1 or 2.
+ */
+template <typename Emit>
+void hanoi_solve_from(const HanoiTowers& towers, std::uint64_t first, std::uint64_t last, Emit&& emit, int to = 2) {
+    HanoiSegment segments[max_hanoi_disks];
+    const int count = hanoi_segments(towers, to, segments);
+    std::uint64_t start = 1;  // the number of the first move of the segment
+    for (int i = 0; i < count && start <= last; ++i) {
+        const HanoiSegment& segment = segments[i];
+        const std::uint64_t length = std::uint64_t(1) << (segment.disk - 1);
+        const std::uint64_t end = start + length - 1;
+        if (end >= first) {
+            if (start >= first)
+                emit(HanoiMove{segment.disk, segment.from, segment.to});
+            const std::uint64_t tower_first = std::max(first, start + 1) - start;
+            const std::uint64_t tower_last = std::min(last, end) - start;
+            if (tower_first <= tower_last)
+                hanoi_iterative(segment.disk - 1, tower_first, tower_last, emit, segment.spare, segment.to);
+        }
+        start = end + 1;
+    }
+}
+
+/**
+ * @brief Generates the whole shortest solution from a configuration.
+ */
+template <typename Emit>
+void hanoi_solve_from(const HanoiTowers& towers, Emit&& emit, int to = 2) {
+    hanoi_solve_from(towers, 1, hanoi_distance(towers, to), std::forward<Emit>(emit), to);
+}
+
+/**
+ * @brief Returns the index of a configuration, the base-3 number whose digit d - 1 is the peg of disk d.
+ */
+inline std::uint64_t hanoi_config_index(const HanoiTowers& towers) {
+    std::uint64_t index = 0;
+    for (int disk = towers.disks(); disk >= 1; --disk)
+        index = 3 * index + static_cast<std::uint64_t>(hanoi_peg_of(towers, disk));
+    return index;
+}
+
+/**
+ * @brief Returns the configuration of n disks with a given index.
+ */
+inline HanoiTowers hanoi_config_from_index(int n, std::uint64_t index) {
+    std::uint64_t masks[3] = {};
+    for (int disk = 1; disk <= n; ++disk, index /= 3)
+        masks[index % 3] |= std::uint64_t(1) << (disk - 1);
+    return HanoiTowers(n, masks);
+}
+
+/**
+ * @brief Returns the distance of every configuration of n disks to the tower on a peg, by breadth-first search.
+ * @details The search takes 3^n entries of memory and is meant to verify hanoi_distance for small n.
+ *
+ * @param n The number of disks, at most 20.
+ * @param to The target peg.
+ * @return std::vector<std::uint32_t> The distances, indexed by hanoi_config_index.
+ * @throws std::invalid_argument If n is above 20 or the target is not 0, 1 or 2.
+ */
+inline std::vector<std::uint32_t> hanoi_bfs_distances(int n, int to = 2) {
+    if (n < 0 || n > 20 || to < 0 || to > 2)
+        throw std::invalid_argument("The search supports up to 20 disks and targets 0, 1 and 2");
+    std::uint64_t states = 1;
+    for (int i = 0; i < n; ++i)
+        states *= 3;
+    constexpr std::uint32_t unseen = ~std::uint32_t(0);
+    std::vector<std::uint32_t> distances(states, unseen);
+
+    std::deque<std::uint64_t> queue;
+    const std::uint64_t goal = hanoi_config_index(HanoiTowers(n, to));
+    distances[goal] = 0;
+    queue.push_back(goal);
+    while (!queue.empty()) {
+        const std::uint64_t index = queue.front();
+        queue.pop_front();
+        const HanoiTowers towers = hanoi_config_from_index(n, index);
+        for (int from = 0; from < 3; ++from) {
+            for (int target = 0; target < 3; ++target) {
+                if (from == target || !towers.can_move(from, target))
+                    continue;
+                HanoiTowers next = towers;
+                next.move(from, target);
+                const std::uint64_t neighbor = hanoi_config_index(next);
+                if (distances[neighbor] == unseen) {
+                    distances[neighbor] = distances[index] + 1;
+                    queue.push_back(neighbor);
+                }
+            }
+        }
+    }
+    return distances;
+}
+
+#endif // HANOI_CONFIG_H
@@ -0,0 +1,138 @@
+/**
+ * @file hanoi_log.cc
+ * @brief A program that measures how fast Tower of Hanoi moves are written as a binary log and as text.
+ * @details Usage: hanoi_log [min_disks] [max_disks] [file]. For every tower size from min_disks to max_disks
+ * (30 to 33 by default) the program writes the binary move log to the file (hanoi.log by default, removed at the
+ * end) and decodes it again, printing gigabytes and moves per second of both, and checks sampled ranges of the decoded moves
+ * against the generator and the states from hanoi_state. The log takes 2^(disks - 1) bytes, so
+ * "hanoi_log 30 36" needs 32 GiB of free space. The text baseline formats the first 2^26 moves with std::cout,
+ * redirected to a file next to the log, or all of them for fewer disks.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "hanoi_log.h"
+
+/**
+ * @brief Times the first moves of a solution written as text through std::cout.
+ *
+ * @param path The file std::cout is redirected to; it is removed afterwards.
+ * @param n The number of disks.
+ * @param moves The number of moves to write.
+ * @return double The seconds taken, including the final flush.
+ */
+double time_text(const std::string& path, int n, std::uint64_t moves) {
+    std::ofstream file(path);
+    std::streambuf* console = std::cout.rdbuf(file.rdbuf());
+    Stopwatch watch;
+    hanoi_iterative(n, 1, moves, [](const HanoiMove& move) { std::cout << move.from << ' ' << move.to << '\n'; });
+    std::cout.flush();
+    double seconds = watch.seconds();
+    std::cout.rdbuf(console);
+    file.close();
+    std::remove(path.c_str());
+    return seconds;
+}
+
+/**
+ * @brief Compares sampled ranges of a log with the generator and replays them from hanoi_state.
+ *
+ * @param log The log.
+ * @param n The number of disks.
+ * @return bool True if all samples agree.
+ */
+bool verify(const HanoiLog& log, int n) {
+    constexpr std::uint64_t samples = 64, length = 4096;
+    const std::uint64_t moves = log.header().moves;
+    for (std::uint64_t s = 0; s < samples; ++s) {
+        std::uint64_t first = 1 + (moves - 1) / samples * s;
+        std::uint64_t last = std::min(moves, first + length - 1);
+        std::vector<HanoiMove> expected;
+        hanoi_iterative(n, first, last, [&expected](const HanoiMove& move) { expected.push_back(move); });
+
+        HanoiTowers towers = hanoi_state(n, first - 1);
+        std::size_t i = 0;
+        bool ok = true;
+        log.decode(first, last, [&](const HanoiMove& move) {
+            const HanoiMove& e = expected[i++];
+            ok = ok && move.disk == e.disk && move.from == e.from && move.to == e.to &&
+                 towers.top(move.from) == move.disk && towers.can_move(move.from, move.to);
+            towers.apply(move);
+        });
+        if (!ok || !(towers == hanoi_state(n, last)))
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief The main function that times the binary log and the text output.
+ *
+ * @param argc The number of command-line arguments provided.
+ * @param argv An array of strings containing the command-line arguments.
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    int min_disks = argc > 1 ? std::stoi(argv[1]) : 30;
+    int max_disks = argc > 2 ? std::stoi(argv[2]) : 33;
+    std::string path = argc > 3 ? argv[3] : "hanoi.log";
+
+    const std::uint64_t text_moves = std::min(std::uint64_t(1) << 26, hanoi_move_count(max_disks));
+    double text_seconds = time_text(path + ".txt", max_disks, text_moves);
+    double text_rate = text_moves / text_seconds;
+    std::cout << "std::cout text: " << std::fixed << std::setprecision(3) << text_moves * 4 / text_seconds / 1e9
+              << " GB/s, " << std::setprecision(1) << text_rate / 1e6 << " Mmoves/s" << std::defaultfloat
+              << std::endl;
+
+    std::cout << std::setw(6) << "disks" << std::setw(10) << "GB" << std::setw(10) << "write s" << std::setw(10)
+              << "GB/s" << std::setw(12) << "Gmoves/s" << std::setw(10) << "vs text" << std::setw(10)
+              << "decode s" << std::setw(12) << "Gmoves/s" << std::setw(10) << "samples" << std::endl;
+    bool all_valid = true;
+    for (int n = min_disks; n <= max_disks; ++n) {
+        const double moves = static_cast<double>(hanoi_move_count(n));
+        Stopwatch watch;
+        std::size_t bytes = write_hanoi_log(path, n);
+        double write_seconds = watch.seconds();
+
+        HanoiLog log(path);
+        watch.reset();
+        std::uint64_t checksum = 0;
+        log.decode([&checksum](const HanoiMove& move) { checksum += move.disk + 3 * move.from + move.to; });
+        double decode_seconds = watch.seconds();
+        do_not_optimize(checksum);
+        bool valid = verify(log, n);
+        all_valid = all_valid && valid;
+
+        std::cout << std::setw(6) << n << std::fixed << std::setprecision(3) << std::setw(10) << bytes / 1e9
+                  << std::setw(10) << write_seconds << std::setw(10) << bytes / write_seconds / 1e9
+                  << std::setw(12) << moves / write_seconds / 1e9 << std::setprecision(1) << std::setw(9)
+                  << moves / write_seconds / text_rate << "x" << std::setprecision(3) << std::setw(10)
+                  << decode_seconds << std::setw(12) << moves / decode_seconds / 1e9 << std::setw(10)
+                  << (valid ? "ok" : "WRONG") << std::defaultfloat << std::endl;
+    }
+    std::remove(path.c_str());
+
+    return all_valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
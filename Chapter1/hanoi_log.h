@@ -0,0 +1,251 @@
+/**
+ * @file hanoi_log.h
+ * @brief A compact binary log of Tower of Hanoi moves, written to and read from memory-mapped files.
+ * @details The log starts with a 32-byte HanoiLogHeader, followed by one 4-bit code per move, source peg in the
+ * low two bits and target peg in the high two, two moves per byte with the earlier move in the low nibble. Move k
+ * is nibble k - 1; its disk is countr_zero(k) + 1 and is not stored.
+ *
+ * The writer cuts the moves into blocks of 2^m moves ending at multiples of 2^m. Within such a block move
+ * h 2^m + l has the same countr_zero as l, and its residue mod 3 is that of l shifted by h 2^m mod 3, so apart
+ * from its last move a block is one of three fixed images. Writing a block is a copy of its image and a patch of
+ * the last nibble, and blocks are independent, so several threads fill their slices of the mapping.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HANOI_LOG_H
+#define HANOI_LOG_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "hanoi.h"
+#include "mapped_file.h"
+
+/**
+ * @brief The header at the start of a move log.
+ */
+struct HanoiLogHeader {
+    char magic[8];  // "HANOILOG"
+    std::uint32_t version;
+    std::uint32_t disks;
+    std::uint64_t moves;
+    std::uint32_t from;
+    std::uint32_t to;
+};
+
+static_assert(sizeof(HanoiLogHeader) == 32, "The log header must have no padding");
+
+inline constexpr char hanoi_log_magic[8] = {'H', 'A', 'N', 'O', 'I', 'L', 'O', 'G'};
+inline constexpr std::uint32_t hanoi_log_version = 1;
+
+/**
+ * @brief The moves per block of the writer are 2^hanoi_log_block_bits.
+ */
+inline constexpr int hanoi_log_block_bits = 16;
+
+/**
+ * @brief The number of blocks in one task of the writer.
+ */
+inline constexpr std::uint64_t hanoi_log_task_blocks = 64;
+
+/**
+ * @brief Returns the 4-bit code of a move.
+ */
+inline std::uint8_t hanoi_log_code(const HanoiMove& move) {
+    return static_cast<std::uint8_t>(move.from | move.to << 2);
+}
+
+/**
+ * @brief Returns the size of the log of a solution of n disks in bytes.
+ *
+ * @throws std::invalid_argument If n is out of range or the log would not fit in memory addresses.
+ */
+inline std::size_t hanoi_log_bytes(int n) {
+    const std::uint64_t moves = hanoi_move_count(n);
+    if (moves / 2 >= std::numeric_limits<std::size_t>::max() - sizeof(HanoiLogHeader))
+        throw std::invalid_argument("The move log is too large for " + std::to_string(n) + " disks");
+    return sizeof(HanoiLogHeader) + static_cast<std::size_t>((moves + 1) / 2);
+}
+
+/**
+ * @brief Writes the log of a solution to a file, block by block on several threads.
+ *
+ * @param path The path of the file, which is created or truncated.
+ * @param n The number of disks.
+ * @param threads The number of threads; 0 means one per hardware thread. It does not change the file.
+ * @param from The peg where the disks start.
+ * @param to The peg where the disks should end up; it differs from from.
+ * @return std::size_t The size of the file in bytes.
+ * @throws std::invalid_argument If n or the pegs are out of range, or the log is too large.
+ * @throws std::system_error If the file cannot be created or mapped.
+ */
+inline std::size_t write_hanoi_log(const std::string& path, int n, unsigned threads = 0, int from = 0, int to = 2) {
+    const HanoiPegTable table(n, from, to);
+    const std::uint64_t moves = hanoi_move_count(n);
+    MappedFile file(path, hanoi_log_bytes(n));
+
+    HanoiLogHeader header{};
+    std::memcpy(header.magic, hanoi_log_magic, sizeof(header.magic));
+    header.version = hanoi_log_version;
+    header.disks = static_cast<std::uint32_t>(n);
+    header.moves = moves;
+    header.from = static_cast<std::uint32_t>(from);
+    header.to = static_cast<std::uint32_t>(to);
+    std::memcpy(file.data(), &header, sizeof(header));
+    auto* payload = reinterpret_cast<std::uint8_t*>(file.data() + sizeof(header));
+
+    if (n <= hanoi_log_block_bits) {  // too short for a single block
+        hanoi_iterative(
+            n,
+            [payload, i = std::uint64_t(0)](const HanoiMove& move) mutable {
+                std::uint8_t code = hanoi_log_code(move);
+                payload[i / 2] = static_cast<std::uint8_t>(i % 2 == 0 ? code : payload[i / 2] | code << 4);
+                ++i;
+            },
+            from, to);
+        return file.size();
+    }
+
+    // images[r] holds moves base + 1 .. base + 2^m - 1 of a block whose base, a multiple of 2^m, is r mod 3.
+    constexpr std::uint64_t block_moves = std::uint64_t(1) << hanoi_log_block_bits;
+    constexpr std::size_t block_bytes = block_moves / 2;
+    std::vector<std::uint8_t> images(3 * block_bytes, 0);
+    for (int r = 0; r < 3; ++r) {
+        std::uint8_t* image = images.data() + r * block_bytes;
+        for (std::uint64_t l = 1; l < block_moves; ++l) {
+            std::uint8_t code = hanoi_log_code(table.move(l, static_cast<int>((r + l) % 3)));
+            image[(l - 1) / 2] |= static_cast<std::uint8_t>((l - 1) % 2 == 0 ? code : code << 4);
+        }
+    }
+
+    const std::uint64_t blocks = (moves + 1) / block_moves;
+    const std::uint64_t tasks = (blocks + hanoi_log_task_blocks - 1) / hanoi_log_task_blocks;
+    std::atomic<std::uint64_t> next{0};
+    auto worker = [&] {
+        for (std::uint64_t t; (t = next.fetch_add(1, std::memory_order_relaxed)) < tasks;) {
+            std::uint64_t end = std::min(blocks, (t + 1) * hanoi_log_task_blocks);
+            for (std::uint64_t h = t * hanoi_log_task_blocks; h < end; ++h) {
+                const std::uint64_t base = h * block_moves;  // the moves are base + 1 .. base + 2^m
+                std::uint8_t* out = payload + h * block_bytes;
+                std::memcpy(out, images.data() + base % 3 * block_bytes, block_bytes);
+                const std::uint64_t last = base + block_moves;
+                if (last <= moves)
+                    out[block_bytes - 1] |= hanoi_log_code(table.move(last, static_cast<int>(last % 3))) << 4;
+            }
+        }
+    };
+
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::clamp<std::uint64_t>(tasks, 1, threads));
+    std::vector<std::thread> workers;
+    for (unsigned w = 1; w < threads; ++w)
+        workers.emplace_back(worker);
+    worker();
+    for (std::thread& w : workers)
+        w.join();
+    return file.size();
+}
+
+/**
+ * @brief A move log mapped for reading.
+ */
+class HanoiLog {
+public:
+    /**
+     * @brief Maps a log and checks its header and size.
+     *
+     * @param path The path of the file.
+     * @throws std::system_error If the file cannot be opened or mapped.
+     * @throws std::runtime_error If the file is not a complete move log.
+     */
+    explicit HanoiLog(const std::string& path) : _file(path) {
+        if (_file.size() < sizeof(HanoiLogHeader))
+            throw std::runtime_error(path + " is too short for a move log");
+        std::memcpy(&_header, _file.data(), sizeof(_header));
+        if (std::memcmp(_header.magic, hanoi_log_magic, sizeof(_header.magic)) != 0 ||
+            _header.version != hanoi_log_version)
+            throw std::runtime_error(path + " is not a move log of version " + std::to_string(hanoi_log_version));
+        if (_header.disks > max_hanoi_disks || _header.moves != hanoi_move_count(static_cast<int>(_header.disks)) ||
+            _header.from > 2 || _header.to > 2 || _header.from == _header.to ||
+            _file.size() != hanoi_log_bytes(static_cast<int>(_header.disks)))
+            throw std::runtime_error(path + " has an inconsistent header or size");
+        _payload = reinterpret_cast<const std::uint8_t*>(_file.data() + sizeof(HanoiLogHeader));
+    }
+
+    /**
+     * @brief Returns the header of the log.
+     */
+    const HanoiLogHeader& header() const {
+        return _header;
+    }
+
+    /**
+     * @brief Returns move k, for k from 1 to the number of moves.
+     */
+    HanoiMove move(std::uint64_t k) const {
+        std::uint8_t code = static_cast<std::uint8_t>(_payload[(k - 1) / 2] >> ((k - 1) % 2 * 4));
+        return {std::countr_zero(k) + 1, code & 3, (code >> 2) & 3};
+    }
+
+    /**
+     * @brief Decodes the moves first to last in order, reading the mapping front to back.
+     *
+     * @param first The number of the first move, at least 1.
+     * @param last The number of the last move, at most the number of moves.
+     * @param emit The callback, called as emit(HanoiMove) for every move.
+     * @throws std::out_of_range If the moves are not within the log.
+     */
+    template <typename Emit>
+    void decode(std::uint64_t first, std::uint64_t last, Emit&& emit) const {
+        if (first == 0 || (first <= last && last > _header.moves))
+            throw std::out_of_range("Moves are numbered from 1 to the number of moves in the log");
+        std::uint64_t k = first;
+        if (k <= last && k % 2 == 0)  // the second move of a byte
+            emit(move(k++));
+        for (; k + 1 <= last; k += 2) {
+            std::uint8_t byte = _payload[(k - 1) / 2];
+            emit(HanoiMove{std::countr_zero(k) + 1, byte & 3, (byte >> 2) & 3});
+            emit(HanoiMove{std::countr_zero(k + 1) + 1, (byte >> 4) & 3, (byte >> 6) & 3});
+        }
+        if (k <= last)
+            emit(move(k));
+    }
+
+    /**
+     * @brief Decodes all moves in order.
+     */
+    template <typename Emit>
+    void decode(Emit&& emit) const {
+        decode(1, _header.moves, std::forward<Emit>(emit));
+    }
+
+private:
+    MappedFile _file;
+    HanoiLogHeader _header;
+    const std::uint8_t* _payload = nullptr;
+};
+
+#endif // HANOI_LOG_H
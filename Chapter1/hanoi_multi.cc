@@ -0,0 +1,129 @@
+/**
+ * @file hanoi_multi.cc
+ * @brief A program that builds the Frame-Stewart table and times the move generator for 4 to 8 pegs.
+ * @details Usage: hanoi_multi [max_disks] [max_moves]. The program builds the table up to max_disks (20000 by
+ * default) and 8 pegs on one thread and on one thread per row, and compares every entry of the two tables.
+ * Then it checks the 4-peg counts against the known values 1, 3, 5, 9, 13, 17, 25, 33, 41, 49 and replays the
+ * solutions of up to 20 disks on bitmask pegs. Finally, for
+ * every peg count, it generates the solution of the most disks that take at most max_moves moves (2^28 by
+ * default) and prints the moves per second.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "hanoi_multi.h"
+
+/**
+ * @brief Replays a solution on one disk mask per peg.
+ *
+ * @param table The table.
+ * @param n The number of disks, at most 63.
+ * @param pegs The number of pegs.
+ * @return bool True if every move is legal, the count matches the table and all disks end on the last peg.
+ */
+bool replay(const FrameStewart& table, int n, int pegs) {
+    std::vector<std::uint64_t> masks(pegs, 0);
+    masks[0] = (std::uint64_t(1) << n) - 1;
+    std::uint64_t count = 0;
+    bool legal = true;
+    table.solve(n, pegs, [&](const HanoiMove& move) {
+        const std::uint64_t disk = std::uint64_t(1) << (move.disk - 1);
+        legal = legal && (masks[move.from] & -masks[move.from]) == disk && (masks[move.to] & (disk - 1)) == 0;
+        masks[move.from] ^= disk;
+        masks[move.to] ^= disk;
+        ++count;
+    });
+    return legal && count == table.moves(n, pegs) && masks[pegs - 1] == (std::uint64_t(1) << n) - 1;
+}
+
+/**
+ * @brief The main function that times the table and the move generator.
+ *
+ * @param argc The number of command-line arguments provided.
+ * @param argv An array of strings containing the command-line arguments.
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    int max_disks = argc > 1 ? std::stoi(argv[1]) : 20000;
+    std::uint64_t max_moves = argc > 2 ? std::stoull(argv[2]) : std::uint64_t(1) << 28;
+    constexpr int max_pegs = 8;
+
+    std::cout << std::setw(8) << "threads" << std::setw(12) << "table s" << std::endl;
+    std::vector<FrameStewart> tables;
+    tables.reserve(2);
+    for (unsigned threads : {1u, unsigned(2 * (max_pegs - 3) + 1)}) {  // more threads than rows splits the search
+        Stopwatch watch;
+        tables.emplace_back(std::max(max_disks, 20), max_pegs, threads);
+        double seconds = watch.seconds();
+        std::cout << std::setw(8) << threads << std::fixed << std::setprecision(3) << std::setw(12) << seconds
+                  << std::defaultfloat << std::endl;
+    }
+
+    const FrameStewart& serial = tables[0];
+    const FrameStewart& table = tables[1];
+    std::uint64_t mismatches = 0;
+    for (int pegs = 3; pegs <= max_pegs; ++pegs) {
+        for (int n = 0; n <= table.max_disks(); ++n)
+            mismatches += table.moves(n, pegs) != serial.moves(n, pegs) || table.split(n, pegs) != serial.split(n, pegs);
+    }
+    std::cout << "parallel table against one thread: " << mismatches << " mismatches" << std::endl;
+    if (mismatches != 0)
+        return EXIT_FAILURE;  // the solutions of a wrong table need not even terminate
+
+    bool valid = true;
+    const std::uint64_t reve[] = {1, 3, 5, 9, 13, 17, 25, 33, 41, 49};
+    for (int n = 1; n <= 10; ++n)
+        valid = valid && table.moves(n, 4) == reve[n - 1];
+    for (int pegs = 3; pegs <= max_pegs; ++pegs) {
+        for (int n = 0; n <= 20; ++n)
+            valid = valid && replay(table, n, pegs);
+    }
+    std::cout << "counts and replays: " << (valid ? "ok" : "WRONG") << std::endl;
+
+    std::cout << std::setw(6) << "pegs" << std::setw(8) << "disks" << std::setw(14) << "moves" << std::setw(8)
+              << "split" << std::setw(10) << "table s" << std::setw(10) << "seconds" << std::setw(12) << "Mmoves/s"
+              << std::endl;
+    for (int pegs = 4; pegs <= max_pegs; ++pegs) {
+        Stopwatch build;
+        const FrameStewart rows(table.max_disks(), pegs);
+        double build_seconds = build.seconds();
+        do_not_optimize(rows.moves(rows.max_disks(), pegs));
+
+        int n = 1;
+        while (n < table.max_disks() && table.moves(n + 1, pegs) <= max_moves)
+            ++n;
+
+        std::uint64_t checksum = 0;
+        Stopwatch watch;
+        table.solve(n, pegs, [&checksum](const HanoiMove& move) { checksum += move.disk + move.from + move.to; });
+        double seconds = watch.seconds();
+        do_not_optimize(checksum);
+
+        std::cout << std::setw(6) << pegs << std::setw(8) << n << std::setw(14) << table.moves(n, pegs)
+                  << std::setw(8) << table.split(n, pegs) << std::fixed << std::setprecision(3) << std::setw(10)
+                  << build_seconds << std::setw(10) << seconds << std::setprecision(1) << std::setw(12) << table.moves(n, pegs) / seconds / 1e6
+                  << std::defaultfloat << std::endl;
+    }
+
+    return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,319 @@
+/**
+ * @file hanoi_multi.h
+ * @brief The Tower of Hanoi with more than three pegs, solved with the Frame-Stewart algorithm.
+ * @details With p pegs, Frame-Stewart moves the t smallest disks aside with all p pegs, the other n - t disks to
+ * the target with the p - 1 remaining pegs, and the t disks on top of them with p pegs again, so
+ * T(n, p) = min over 1 <= t < n of 2 T(t, p) + T(n - t, p - 1), with T(n, 3) = 2^n - 1. FrameStewart tabulates
+ * T and the best split t for all disk and peg counts up to a limit.
+ *
+ * Entry (n, p) reads entries 1 .. n - 1 of row p and 0 .. n of row p - 1, so the rows form a wavefront: each row
+ * is filled by its own team of threads, which waits only until the row below holds the entries it reads. With
+ * more threads than rows, each team splits the O(n) search over t of an entry between its threads.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HANOI_MULTI_H
+#define HANOI_MULTI_H
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "hanoi.h"
+
+/**
+ * @brief The Frame-Stewart table of move counts and splits.
+ */
+class FrameStewart {
+public:
+    /**
+     * @brief Move counts that do not fit in 64 bits are stored as this value.
+     */
+    static constexpr std::uint64_t saturated = std::numeric_limits<std::uint64_t>::max();
+
+    /**
+     * @brief The largest peg count, limited by the 32-bit peg sets of the solver.
+     */
+    static constexpr int max_supported_pegs = 32;
+
+    /**
+     * @brief Builds the table.
+     *
+     * @param max_disks The largest number of disks.
+     * @param max_pegs The largest number of pegs, from 3 to max_supported_pegs.
+     * @param threads The number of threads; 0 means one per hardware thread. It does not change the table.
+     * @throws std::invalid_argument If the limits are out of range.
+     */
+    FrameStewart(int max_disks, int max_pegs, unsigned threads = 0) : _max_disks(max_disks), _max_pegs(max_pegs) {
+        if (max_disks < 0 || max_pegs < 3 || max_pegs > max_supported_pegs)
+            throw std::invalid_argument("The table needs at least 0 disks and 3 to 32 pegs");
+        const std::size_t entries = std::size_t(max_disks + 1) * std::size_t(max_pegs - 2);
+        _moves.assign(entries, 0);
+        _splits.assign(entries, 0);
+        for (int n = 0; n <= max_disks; ++n) {
+            _moves[_index(n, 3)] = n < 64 ? (std::uint64_t(1) << n) - 1 : saturated;
+            _splits[_index(n, 3)] = n > 0 ? n - 1 : 0;
+        }
+
+        const int rows = max_pegs - 3;
+        if (rows == 0)
+            return;
+        // progress[p - 3] counts the finished entries of row p; row 3 is complete.
+        std::unique_ptr<std::atomic<int>[]> progress(new std::atomic<int>[rows + 1]);
+        progress[0].store(max_disks + 1);
+        for (int row = 1; row <= rows; ++row)
+            progress[row].store(0);
+
+        // Rows go round-robin to teams; the threads left over join the teams and split the search over t.
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        const unsigned teams = std::min<unsigned>(threads, rows);
+        std::vector<std::unique_ptr<std::barrier<>>> barriers;
+        std::vector<std::vector<Candidate>> partials;
+        std::vector<unsigned> members;
+        for (unsigned team = 0; team < teams; ++team) {
+            members.push_back(threads / teams + (team < threads % teams ? 1 : 0));
+            barriers.push_back(std::make_unique<std::barrier<>>(members.back()));
+            partials.emplace_back(std::size_t(members.back()) * fill_block);
+        }
+        auto worker = [&](unsigned team, unsigned member) {
+            for (int p = 4 + static_cast<int>(team); p <= max_pegs; p += static_cast<int>(teams))
+                _fill_row(p, progress[p - 4], progress[p - 3], *barriers[team], member, members[team],
+                          partials[team].data());
+        };
+        std::vector<std::thread> workers;
+        for (unsigned team = 0; team < teams; ++team) {
+            for (unsigned member = team == 0 ? 1 : 0; member < members[team]; ++member)
+                workers.emplace_back(worker, team, member);
+        }
+        worker(0, 0);
+        for (std::thread& w : workers)
+            w.join();
+    }
+
+    /**
+     * @brief Returns the largest number of disks in the table.
+     */
+    int max_disks() const {
+        return _max_disks;
+    }
+
+    /**
+     * @brief Returns the largest number of pegs in the table.
+     */
+    int max_pegs() const {
+        return _max_pegs;
+    }
+
+    /**
+     * @brief Returns the Frame-Stewart move count of n disks on p pegs, or saturated if it exceeds 64 bits.
+     */
+    std::uint64_t moves(int n, int pegs) const {
+        _check(n, pegs);
+        return _moves[_index(n, pegs)];
+    }
+
+    /**
+     * @brief Returns the number of smallest disks that the best solution moves aside first.
+     */
+    int split(int n, int pegs) const {
+        _check(n, pegs);
+        return _splits[_index(n, pegs)];
+    }
+
+    /**
+     * @brief Generates the moves of the Frame-Stewart solution without recursion, passing each move to a callback.
+     * @details An explicit stack of sub-problems replaces the recursion; a sub-problem left with three pegs is
+     * handed to hanoi_iterative.
+     *
+     * @param n The number of disks.
+     * @param pegs The number of pegs.
+     * @param emit The callback, called as emit(HanoiMove) for every move in order.
+     * @param from The peg where the disks start.
+     * @param to The peg where the disks should end up; it differs from from.
+     * @throws std::invalid_argument If n, the pegs or the peg count are out of range.
+     * @throws std::overflow_error If the number of moves does not fit in 64 bits.
+     */
+    template <typename Emit>
+    void solve(int n, int pegs, Emit&& emit, int from = 0, int to = -1) const {
+        if (to < 0)
+            to = pegs - 1;
+        _check(n, pegs);
+        if (from < 0 || from >= pegs || to < 0 || to >= pegs || from == to)
+            throw std::invalid_argument("The pegs must be two different pegs below the peg count");
+        if (moves(n, pegs) == saturated)
+            throw std::overflow_error("The number of moves does not fit in 64 bits");
+
+        struct Problem {
+            int count;  // the disks offset + 1 .. offset + count
+            int offset;
+            int from;
+            int to;
+            std::uint32_t spares;  // the other pegs it may use
+            int stage;  // the number of its three parts already pushed
+        };
+        const std::uint32_t all = pegs == 32 ? ~std::uint32_t(0) : (std::uint32_t(1) << pegs) - 1;
+        std::vector<Problem> stack;
+        stack.reserve(std::size_t(n) + std::size_t(pegs) + 1);
+        stack.push_back({n, 0, from, to, all & ~(std::uint32_t(1) << from) & ~(std::uint32_t(1) << to), 0});
+
+        while (!stack.empty()) {
+            Problem& top = stack.back();
+            const int available = std::popcount(top.spares) + 2;
+            if (top.count == 0 || (top.stage == 0 && (available == 3 || top.count == 1))) {
+                if (top.count > 0) {
+                    const int offset = top.offset, a = top.from, b = top.to;
+                    const int spare = top.spares == 0 ? -1 : std::countr_zero(top.spares);
+                    const int labels[3] = {a, spare, b};
+                    hanoi_iterative(
+                        top.count,
+                        [&emit, &labels, offset](const HanoiMove& move) {
+                            emit(HanoiMove{move.disk + offset, labels[move.from], labels[move.to]});
+                        },
+                        0, 2);
+                }
+                stack.pop_back();
+                continue;
+            }
+
+            const int t = _splits[_index(top.count, available)];
+            const int via = std::countr_zero(top.spares);
+            const std::uint32_t others = top.spares & ~(std::uint32_t(1) << via);
+            const Problem current = top;
+            switch (current.stage) {
+                case 0:  // the t smallest disks aside to via, with all pegs
+                    top.stage = 1;
+                    stack.push_back({t, current.offset, current.from, via, others | std::uint32_t(1) << current.to, 0});
+                    break;
+                case 1:  // the larger disks to the target, without via
+                    top.stage = 2;
+                    stack.push_back({current.count - t, current.offset + t, current.from, current.to, others, 0});
+                    break;
+                case 2:  // the t smallest disks onto them
+                    top.stage = 3;
+                    stack.push_back({t, current.offset, via, current.to, others | std::uint32_t(1) << current.from, 0});
+                    break;
+                default:
+                    stack.pop_back();
+                    break;
+            }
+        }
+    }
+
+private:
+    std::size_t _index(int n, int pegs) const {
+        return std::size_t(pegs - 3) * std::size_t(_max_disks + 1) + std::size_t(n);
+    }
+
+    void _check(int n, int pegs) const {
+        if (n < 0 || n > _max_disks || pegs < 3 || pegs > _max_pegs)
+            throw std::invalid_argument("The disk or peg count is outside the table");
+    }
+
+    /**
+     * @brief A split and its move count.
+     */
+    struct Candidate {
+        std::uint64_t moves;
+        int split;
+    };
+
+    /**
+     * @brief The number of entries a team of several threads fills between two barriers.
+     */
+    static constexpr int fill_block = 64;
+
+    /**
+     * @brief Returns the best split of n disks over 1 <= t < n within [first, last), or saturated with split 0.
+     * @details Ties go to the smallest t, so candidates from consecutive ranges combine in any grouping.
+     */
+    static Candidate _best_split(const std::uint64_t* row, const std::uint64_t* lower, int n, int first, int last) {
+        Candidate best{saturated, 0};
+        for (int t = first; t < last; ++t) {
+            const std::uint64_t aside = row[t], rest = lower[n - t];
+            if (aside > (saturated - rest) / 2)
+                continue;
+            const std::uint64_t total = 2 * aside + rest;
+            if (total < best.moves)
+                best = {total, t};
+        }
+        return best;
+    }
+
+    /**
+     * @brief Fills row p as one member of a team, waiting for the entries of row p - 1 it reads.
+     * @details A team of one fills the row entry by entry. A larger team fills it in blocks of fill_block
+     * entries: for the entries of a block, the members split the splits t below the block, whose row entries are
+     * final, and the first member combines their candidates with the few splits inside the block. Progress is
+     * published exactly as often as the row above consumes it.
+     */
+    void _fill_row(int pegs, std::atomic<int>& below, std::atomic<int>& done, std::barrier<>& team,
+                   unsigned member, unsigned members, Candidate* partials) {
+        const std::uint64_t* lower = _moves.data() + _index(0, pegs - 1);
+        std::uint64_t* row = _moves.data() + _index(0, pegs);
+        int* splits = _splits.data() + _index(0, pegs);
+        const int block = members == 1 ? 1 : fill_block;
+
+        for (int first = 0; first <= _max_disks; first += block) {
+            const int last = std::min(_max_disks + 1, first + block);
+            for (int ready = below.load(std::memory_order_acquire); ready < last;  // lower[n] is read for every n
+                 ready = below.load(std::memory_order_acquire))
+                below.wait(ready, std::memory_order_acquire);
+
+            const int splits_below = std::max(first - 1, 0);  // t in [1, first)
+            const int t_begin = 1 + static_cast<int>(std::int64_t(splits_below) * member / members);
+            const int t_end = 1 + static_cast<int>(std::int64_t(splits_below) * (member + 1) / members);
+            for (int n = first; n < last; ++n)
+                partials[member * block + (n - first)] = _best_split(row, lower, n, t_begin, t_end);
+            if (members > 1)
+                team.arrive_and_wait();
+
+            if (member == 0) {
+                for (int n = first; n < last; ++n) {
+                    Candidate best{n == 0 ? 0 : lower[n], 0};  // t = 0, which stays valid for n <= 1
+                    for (unsigned m = 0; m < members; ++m) {
+                        const Candidate& candidate = partials[m * block + (n - first)];
+                        if (candidate.moves < best.moves)
+                            best = candidate;
+                    }
+                    const Candidate inside = _best_split(row, lower, n, std::max(first, 1), n);
+                    if (inside.moves < best.moves)
+                        best = inside;
+                    row[n] = best.moves;
+                    splits[n] = best.split;
+                }
+                done.store(last, std::memory_order_release);
+                done.notify_all();
+            }
+            if (members > 1)
+                team.arrive_and_wait();
+        }
+    }
+
+    int _max_disks;
+    int _max_pegs;
+    std::vector<std::uint64_t> _moves;
+    std::vector<int> _splits;
+};
+
+#endif // HANOI_MULTI_H
@@ -0,0 +1,96 @@
+/**
+ * @file hanoi_parallel.cc
+ * @brief A program that writes the moves of a large Tower of Hanoi solution to a memory-mapped file in parallel.
+ * @details Usage: hanoi_parallel [disks] [file]. The program writes the 2^disks - 1 moves (26 disks by default)
+ * to the file (hanoi.txt by default) with a growing number of threads and prints the moves and megabytes per
+ * second. It then maps the file for reading and checks every chunk: replayed from hanoi_state at the start of
+ * the chunk, its moves must be legal and end in hanoi_state at the end of the chunk. The file is removed at the
+ * end.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "benchmark.h"
+#include "hanoi_parallel.h"
+
+/**
+ * @brief Checks the moves of every chunk of a file against the states at the chunk boundaries.
+ *
+ * @param file The mapped move file.
+ * @param n The number of disks.
+ * @return bool True if all chunks are legal and consistent.
+ */
+bool verify(const MappedFile& file, int n) {
+    const std::uint64_t moves = hanoi_move_count(n);
+    if (file.size() != moves * hanoi_record_bytes)
+        return false;
+    for (std::uint64_t first = 1; first <= moves; first += hanoi_chunk_moves) {
+        std::uint64_t last = std::min(moves, first + hanoi_chunk_moves - 1);
+        HanoiTowers towers = hanoi_state(n, first - 1);
+        for (std::uint64_t k = first; k <= last; ++k) {
+            int from, to;
+            read_hanoi_record(file.data() + (k - 1) * hanoi_record_bytes, from, to);
+            if (from < 0 || from > 2 || to < 0 || to > 2 || !towers.can_move(from, to))
+                return false;
+            towers.move(from, to);
+        }
+        if (!(towers == hanoi_state(n, last)))
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief The main function that times the parallel writer and verifies its output.
+ *
+ * @param argc The number of command-line arguments provided.
+ * @param argv An array of strings containing the command-line arguments.
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    int n = argc > 1 ? std::stoi(argv[1]) : 26;
+    std::string path = argc > 2 ? argv[2] : "hanoi.txt";
+    unsigned max_threads = std::max(4u, std::thread::hardware_concurrency());
+    const std::uint64_t moves = hanoi_move_count(n);
+
+    std::cout << "disks: " << n << ", moves: " << moves << std::endl;
+    std::cout << std::setw(8) << "threads" << std::setw(10) << "seconds" << std::setw(12) << "Mmoves/s"
+              << std::setw(10) << "MB/s" << std::endl;
+    for (unsigned threads = 1;; threads = std::min(2 * threads, max_threads)) {
+        Stopwatch watch;
+        std::size_t bytes = write_hanoi_moves_parallel(path, n, threads);
+        double seconds = watch.seconds();
+        std::cout << std::setw(8) << threads << std::fixed << std::setprecision(3) << std::setw(10) << seconds
+                  << std::setprecision(1) << std::setw(12) << moves / seconds / 1e6 << std::setw(10)
+                  << bytes / seconds / 1e6 << std::defaultfloat << std::endl;
+        if (threads == max_threads)
+            break;
+    }
+
+    Stopwatch watch;
+    bool valid = verify(MappedFile(path), n);
+    std::cout << "chunks " << (valid ? "verified" : "INVALID") << " in " << std::setprecision(3) << watch.seconds()
+              << " s" << std::endl;
+    std::remove(path.c_str());
+    return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
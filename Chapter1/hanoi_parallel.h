@@ -0,0 +1,127 @@
+/**
+ * @file hanoi_parallel.h
+ * @brief Writes the moves of a large Tower of Hanoi solution to a memory-mapped file on several threads.
+ * @details Every move is a fixed-width text record "f t\n", so move k sits at byte 4 (k - 1) of the file. The
+ * 2^n - 1 moves are cut into chunks of consecutive moves; since hanoi_iterative starts at any move number and
+ * hanoi_state gives the state at any chunk boundary, chunks need nothing from each other and every thread
+ * writes its chunks straight into their slices of the mapping.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HANOI_PARALLEL_H
+#define HANOI_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "hanoi.h"
+#include "mapped_file.h"
+
+/**
+ * @brief The bytes of one text move record, "f t\n".
+ */
+inline constexpr std::size_t hanoi_record_bytes = 4;
+
+/**
+ * @brief The number of moves in one chunk of the parallel writer.
+ */
+inline constexpr std::uint64_t hanoi_chunk_moves = std::uint64_t(1) << 20;
+
+/**
+ * @brief Writes the text records of moves first to last into a buffer.
+ *
+ * @param out The record of move first; the buffer must hold last - first + 1 records.
+ * @param n The number of disks.
+ * @param first The number of the first move, at least 1.
+ * @param last The number of the last move, at most 2^n - 1.
+ * @param from The peg where the disks start.
+ * @param to The peg where the disks should end up.
+ */
+inline void write_hanoi_records(char* out, int n, std::uint64_t first, std::uint64_t last, int from = 0,
+                                int to = 2) {
+    hanoi_iterative(
+        n, first, last,
+        [&out](const HanoiMove& move) {
+            out[0] = static_cast<char>('0' + move.from);
+            out[1] = ' ';
+            out[2] = static_cast<char>('0' + move.to);
+            out[3] = '\n';
+            out += hanoi_record_bytes;
+        },
+        from, to);
+}
+
+/**
+ * @brief Reads a text move record.
+ *
+ * @param record The four bytes of the record.
+ * @param from Receives the source peg.
+ * @param to Receives the target peg.
+ */
+inline void read_hanoi_record(const char* record, int& from, int& to) {
+    from = record[0] - '0';
+    to = record[2] - '0';
+}
+
+/**
+ * @brief Writes all moves of a solution to a file, one chunk of moves per task on several threads.
+ *
+ * @param path The path of the file, which is created or truncated.
+ * @param n The number of disks.
+ * @param threads The number of threads; 0 means one per hardware thread. It does not change the file.
+ * @param from The peg where the disks start.
+ * @param to The peg where the disks should end up; it differs from from.
+ * @return std::size_t The size of the file in bytes.
+ * @throws std::invalid_argument If n or the pegs are out of range, or the file would not fit in memory addresses.
+ * @throws std::system_error If the file cannot be created or mapped.
+ */
+inline std::size_t write_hanoi_moves_parallel(const std::string& path, int n, unsigned threads = 0, int from = 0,
+                                              int to = 2) {
+    const HanoiPegTable table(n, from, to);  // checks the pegs before the file is touched, not on a worker thread
+    const std::uint64_t moves = hanoi_move_count(n);
+    if (moves > std::numeric_limits<std::size_t>::max() / hanoi_record_bytes)
+        throw std::invalid_argument("The move file is too large for " + std::to_string(n) + " disks");
+    MappedFile file(path, moves * hanoi_record_bytes);
+
+    const std::uint64_t chunks = (moves + hanoi_chunk_moves - 1) / hanoi_chunk_moves;
+    std::atomic<std::uint64_t> next{0};
+    auto worker = [&] {
+        for (std::uint64_t c; (c = next.fetch_add(1, std::memory_order_relaxed)) < chunks;) {
+            std::uint64_t first = c * hanoi_chunk_moves + 1;
+            std::uint64_t last = std::min(moves, first + hanoi_chunk_moves - 1);
+            write_hanoi_records(file.data() + (first - 1) * hanoi_record_bytes, n, first, last, from, to);
+        }
+    };
+
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::clamp<std::uint64_t>(chunks, 1, threads));
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; ++t)
+        workers.emplace_back(worker);
+    worker();
+    for (std::thread& w : workers)
+        w.join();
+    return file.size();
+}
+
+#endif // HANOI_PARALLEL_H
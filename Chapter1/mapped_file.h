@@ -0,0 +1,140 @@
+/**
+ * @file mapped_file.h
+ * @brief A file mapped into memory with mmap, for output that many threads write at known offsets.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Owns a shared mapping of a whole file, writable or read-only.
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Creates or truncates a file of a given size and maps it for writing.
+     *
+     * @param path The path of the file.
+     * @param size The size of the file in bytes.
+     * @throws std::system_error If the file cannot be created, sized or mapped.
+     */
+    MappedFile(const std::string& path, std::size_t size) : _size(size) {
+        _fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (_fd < 0)
+            _fail("Cannot create " + path);
+        if (::ftruncate(_fd, static_cast<off_t>(size)) != 0)
+            _fail("Cannot resize " + path);
+        _map(PROT_READ | PROT_WRITE, path);
+    }
+
+    /**
+     * @brief Maps an existing file for reading.
+     *
+     * @param path The path of the file.
+     * @throws std::system_error If the file cannot be opened or mapped.
+     */
+    explicit MappedFile(const std::string& path) {
+        _fd = ::open(path.c_str(), O_RDONLY);
+        if (_fd < 0)
+            _fail("Cannot open " + path);
+        struct stat status;
+        if (::fstat(_fd, &status) != 0)
+            _fail("Cannot read the size of " + path);
+        _size = static_cast<std::size_t>(status.st_size);
+        _map(PROT_READ, path);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept
+        : _fd(std::exchange(other._fd, -1)), _data(std::exchange(other._data, nullptr)),
+          _size(std::exchange(other._size, 0)) {}
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            _release();
+            _fd = std::exchange(other._fd, -1);
+            _data = std::exchange(other._data, nullptr);
+            _size = std::exchange(other._size, 0);
+        }
+        return *this;
+    }
+
+    ~MappedFile() {
+        _release();
+    }
+
+    /**
+     * @brief Returns the first byte of the mapping, which is writable only for a created file.
+     */
+    char* data() {
+        return _data;
+    }
+
+    const char* data() const {
+        return _data;
+    }
+
+    /**
+     * @brief Returns the size of the file in bytes.
+     */
+    std::size_t size() const {
+        return _size;
+    }
+
+private:
+    void _map(int protection, const std::string& path) {
+        if (_size == 0)
+            return;  // mmap rejects empty mappings
+        void* address = ::mmap(nullptr, _size, protection, MAP_SHARED, _fd, 0);
+        if (address == MAP_FAILED)
+            _fail("Cannot map " + path);
+        _data = static_cast<char*>(address);
+    }
+
+    [[noreturn]] void _fail(const std::string& what) {
+        int error = errno;
+        _release();
+        throw std::system_error(error, std::generic_category(), what);
+    }
+
+    void _release() {
+        if (_data != nullptr)
+            ::munmap(_data, _size);
+        if (_fd >= 0)
+            ::close(_fd);
+        _data = nullptr;
+        _fd = -1;
+    }
+
+    int _fd = -1;
+    char* _data = nullptr;
+    std::size_t _size = 0;
+};
+
+#endif // MAPPED_FILE_H
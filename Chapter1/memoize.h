@@ -0,0 +1,487 @@
+/**
+ * @file memoize.h
+ * @brief A reusable memoization wrapper with interchangeable cache backends, the C++ counterpart of functools.lru_cache.
+ * @details memoize() wraps a function of one key into a callable that looks every key up in a cache before
+ * calling the function. The function receives the memoized callable as its first argument, so recursive calls
+ * go through the cache too. Three backends are provided: FlatHashCache (unbounded open-addressing hash table),
+ * LruCache (bounded, evicts the least recently used entry) and DirectCache (an array indexed by dense integer
+ * keys). Every memoized callable counts its hits and misses so the backends can be compared on a workload.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MEMOIZE_H
+#define MEMOIZE_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Hit and miss counters of a memoized function.
+ */
+struct CacheStats {
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+
+    /**
+     * @brief Returns the fraction of calls answered from the cache.
+     *
+     * @return double The hit rate, or zero if there were no calls.
+     */
+    double hit_rate() const {
+        std::uint64_t calls = hits + misses;
+        return calls == 0 ? 0 : double(hits) / calls;
+    }
+};
+
+/**
+ * @brief An open-addressing hash map with linear probing and backward-shift deletion.
+ * @details All entries live in one contiguous array whose capacity is a power of two kept at most half full.
+ * Hashes are scrambled with a multiplicative (Fibonacci) hash, because std::hash of an integer is usually the
+ * identity and would cluster sequential keys.
+ *
+ * @tparam K The key type; it must be default constructible.
+ * @tparam V The value type; it must be default constructible.
+ * @tparam Hash The hash function.
+ */
+template <typename K, typename V, typename Hash = std::hash<K>>
+class FlatHashMap {
+public:
+    /**
+     * @brief Constructs an empty map.
+     *
+     * @param capacity The initial number of slots, rounded up to a power of two.
+     */
+    explicit FlatHashMap(std::size_t capacity = 16) {
+        _rehash(std::bit_ceil(std::max<std::size_t>(capacity, 2)));
+    }
+
+    /**
+     * @brief Returns the value of a key.
+     *
+     * @param key The key to look up.
+     * @return V* A pointer to the value, or nullptr if the key is absent; it is invalidated by the next insertion.
+     */
+    V* find(const K& key) {
+        for (std::size_t i = _home(key);; i = (i + 1) & _mask) {
+            if (!_slots[i].used)
+                return nullptr;
+            if (_slots[i].key == key)
+                return &_slots[i].value;
+        }
+    }
+
+    /**
+     * @brief Inserts a key or replaces its value.
+     *
+     * @param key The key.
+     * @param value The value.
+     */
+    void insert_or_assign(const K& key, V value) {
+        if (2 * (_size + 1) > _slots.size())
+            _rehash(2 * _slots.size());
+        std::size_t i = _home(key);
+        for (; _slots[i].used; i = (i + 1) & _mask) {
+            if (_slots[i].key == key) {
+                _slots[i].value = std::move(value);
+                return;
+            }
+        }
+        _slots[i].key = key;
+        _slots[i].value = std::move(value);
+        _slots[i].used = true;
+        ++_size;
+    }
+
+    /**
+     * @brief Removes a key.
+     *
+     * @param key The key to be removed.
+     * @return bool True if the key was present.
+     */
+    bool erase(const K& key) {
+        std::size_t i = _home(key);
+        for (; _slots[i].used; i = (i + 1) & _mask) {
+            if (_slots[i].key == key)
+                break;
+        }
+        if (!_slots[i].used)
+            return false;
+
+        // Shift later members of the probe run back so no lookup meets a hole before reaching its key.
+        for (std::size_t j = (i + 1) & _mask; _slots[j].used; j = (j + 1) & _mask) {
+            std::size_t home = _home(_slots[j].key);
+            if (((i - home) & _mask) < ((j - home) & _mask)) {
+                _slots[i] = std::move(_slots[j]);
+                i = j;
+            }
+        }
+        _slots[i].used = false;
+        --_size;
+        return true;
+    }
+
+    /**
+     * @brief Returns the number of keys in the map.
+     *
+     * @return std::size_t The number of keys.
+     */
+    std::size_t size() const {
+        return _size;
+    }
+
+    /**
+     * @brief Removes every key.
+     */
+    void clear() {
+        for (Slot& slot : _slots)
+            slot.used = false;
+        _size = 0;
+    }
+
+private:
+    struct Slot {
+        K key{};
+        V value{};
+        bool used = false;
+    };
+
+    std::size_t _home(const K& key) const {
+        return (static_cast<std::uint64_t>(Hash{}(key)) * 0x9e3779b97f4a7c15ULL) >> _shift;
+    }
+
+    void _rehash(std::size_t capacity) {
+        std::vector<Slot> old = std::move(_slots);
+        _slots.assign(capacity, Slot());
+        _mask = capacity - 1;
+        _shift = 64 - std::countr_zero(capacity);
+        _size = 0;
+        for (Slot& slot : old) {
+            if (slot.used)
+                insert_or_assign(slot.key, std::move(slot.value));
+        }
+    }
+
+    std::vector<Slot> _slots;
+    std::size_t _size = 0;
+    std::size_t _mask = 0;
+    int _shift = 0;
+};
+
+/**
+ * @brief An unbounded cache backed by a FlatHashMap.
+ *
+ * @tparam K The key type.
+ * @tparam V The value type.
+ */
+template <typename K, typename V>
+class FlatHashCache {
+public:
+    using key_type = K;
+    using value_type = V;
+
+    const V* find(const K& key) {
+        return _map.find(key);
+    }
+
+    void insert(const K& key, const V& value) {
+        _map.insert_or_assign(key, value);
+    }
+
+    std::size_t size() const {
+        return _map.size();
+    }
+
+    void clear() {
+        _map.clear();
+    }
+
+private:
+    FlatHashMap<K, V> _map;
+};
+
+/**
+ * @brief A cache bounded to a fixed number of entries that evicts the least recently used one.
+ * @details Entries are stored in one preallocated array and linked into a recency list by index, so no memory is
+ * allocated once the cache is full.
+ *
+ * @tparam K The key type.
+ * @tparam V The value type.
+ */
+template <typename K, typename V>
+class LruCache {
+public:
+    using key_type = K;
+    using value_type = V;
+
+    /**
+     * @brief Constructs an empty cache.
+     *
+     * @param capacity The maximum number of entries.
+     * @throws std::invalid_argument If capacity is zero.
+     */
+    explicit LruCache(std::size_t capacity = 1024) : _index(2 * capacity), _capacity(capacity) {
+        if (capacity == 0 || capacity >= none)
+            throw std::invalid_argument("LruCache capacity must be between 1 and 2^32 - 2");
+        _nodes.reserve(capacity);
+    }
+
+    const V* find(const K& key) {
+        std::uint32_t* node = _index.find(key);
+        if (node == nullptr)
+            return nullptr;
+        _move_to_front(*node);
+        return &_nodes[*node].value;
+    }
+
+    void insert(const K& key, const V& value) {
+        if (std::uint32_t* existing = _index.find(key)) {
+            _nodes[*existing].value = value;
+            _move_to_front(*existing);
+            return;
+        }
+
+        std::uint32_t node;
+        if (_nodes.size() < _capacity) {
+            node = static_cast<std::uint32_t>(_nodes.size());
+            _nodes.push_back({key, value, none, none});
+        } else {
+            node = _tail;  // reuse the least recently used entry
+            _unlink(node);
+            _index.erase(_nodes[node].key);
+            _nodes[node].key = key;
+            _nodes[node].value = value;
+            ++_evictions;
+        }
+        _push_front(node);
+        _index.insert_or_assign(key, node);
+    }
+
+    std::size_t size() const {
+        return _nodes.size();
+    }
+
+    void clear() {
+        _nodes.clear();
+        _index.clear();
+        _head = _tail = none;
+    }
+
+    /**
+     * @brief Returns how many entries have been evicted.
+     *
+     * @return std::uint64_t The number of evictions.
+     */
+    std::uint64_t evictions() const {
+        return _evictions;
+    }
+
+private:
+    static constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+
+    struct Node {
+        K key;
+        V value;
+        std::uint32_t previous;
+        std::uint32_t next;
+    };
+
+    void _unlink(std::uint32_t node) {
+        Node& n = _nodes[node];
+        (n.previous == none ? _head : _nodes[n.previous].next) = n.next;
+        (n.next == none ? _tail : _nodes[n.next].previous) = n.previous;
+    }
+
+    void _push_front(std::uint32_t node) {
+        _nodes[node].previous = none;
+        _nodes[node].next = _head;
+        (_head == none ? _tail : _nodes[_head].previous) = node;
+        _head = node;
+    }
+
+    void _move_to_front(std::uint32_t node) {
+        if (node != _head) {
+            _unlink(node);
+            _push_front(node);
+        }
+    }
+
+    std::vector<Node> _nodes;
+    FlatHashMap<K, std::uint32_t> _index;
+    std::size_t _capacity;
+    std::uint32_t _head = none;
+    std::uint32_t _tail = none;
+    std::uint64_t _evictions = 0;
+};
+
+/**
+ * @brief A cache for dense non-negative integer keys, stored in an array indexed by the key.
+ * @details Keys at or above the capacity are not cached, which keeps the memory bounded when a few keys are
+ * far outside the dense range.
+ *
+ * @tparam K An integer key type.
+ * @tparam V The value type.
+ */
+template <typename K, typename V>
+class DirectCache {
+public:
+    static_assert(std::is_integral_v<K>, "DirectCache needs integer keys");
+
+    using key_type = K;
+    using value_type = V;
+
+    /**
+     * @brief Constructs an empty cache.
+     *
+     * @param capacity Keys in [0, capacity) are cached.
+     */
+    explicit DirectCache(std::size_t capacity = std::size_t(1) << 20) : _capacity(capacity) {}
+
+    const V* find(const K& key) {
+        if (!_in_range(key, _present.size()) || !_present[key])
+            return nullptr;
+        return &_values[key];
+    }
+
+    void insert(const K& key, const V& value) {
+        if (!_in_range(key, _capacity))
+            return;
+        std::size_t index = static_cast<std::size_t>(key);
+        if (index >= _present.size()) {
+            std::size_t size = std::min(_capacity, std::max(index + 1, 2 * _present.size()));
+            _values.resize(size);
+            _present.resize(size, 0);
+        }
+        _size += !_present[index];
+        _values[index] = value;
+        _present[index] = 1;
+    }
+
+    std::size_t size() const {
+        return _size;
+    }
+
+    void clear() {
+        _values.clear();
+        _present.clear();
+        _size = 0;
+    }
+
+private:
+    static bool _in_range(const K& key, std::size_t limit) {
+        if constexpr (std::is_signed_v<K>) {
+            if (key < 0)
+                return false;
+        }
+        return static_cast<std::size_t>(key) < limit;
+    }
+
+    std::vector<V> _values;
+    std::vector<std::uint8_t> _present;
+    std::size_t _capacity;
+    std::size_t _size = 0;
+};
+
+/**
+ * @brief A function of one key whose results are kept in a cache.
+ *
+ * @tparam Cache The cache backend.
+ * @tparam F The wrapped function, called as f(memoized, key).
+ */
+template <typename Cache, typename F>
+class Memoized {
+public:
+    using key_type = typename Cache::key_type;
+    using value_type = typename Cache::value_type;
+
+    /**
+     * @brief Constructs a memoized function.
+     *
+     * @param function The function to be memoized; it receives this object to make recursive calls.
+     * @param cache The cache backend.
+     */
+    Memoized(F function, Cache cache) : _function(std::move(function)), _cache(std::move(cache)) {}
+
+    /**
+     * @brief Returns the cached result for a key, calling the function on a miss.
+     *
+     * @param key The argument.
+     * @return value_type The result.
+     */
+    value_type operator()(const key_type& key) {
+        if (const value_type* cached = _cache.find(key)) {
+            ++_stats.hits;
+            return *cached;
+        }
+        ++_stats.misses;
+        value_type value = _function(*this, key);
+        _cache.insert(key, value);
+        return value;
+    }
+
+    /**
+     * @brief Returns the hit and miss counters.
+     *
+     * @return const CacheStats& The counters.
+     */
+    const CacheStats& stats() const {
+        return _stats;
+    }
+
+    /**
+     * @brief Returns the cache backend.
+     *
+     * @return Cache& The cache.
+     */
+    Cache& cache() {
+        return _cache;
+    }
+
+    /**
+     * @brief Empties the cache and resets the counters.
+     */
+    void clear() {
+        _cache.clear();
+        _stats = CacheStats();
+    }
+
+private:
+    F _function;
+    Cache _cache;
+    CacheStats _stats;
+};
+
+/**
+ * @brief Wraps a function of one key into a memoized callable.
+ *
+ * @tparam Cache The cache backend, for example FlatHashCache<int, long>.
+ * @tparam F The type of the function, called as f(memoized, key).
+ * @param function The function to be memoized.
+ * @param cache The cache backend.
+ * @return Memoized<Cache, F> The memoized callable.
+ */
+template <typename Cache, typename F>
+Memoized<Cache, F> memoize(F function, Cache cache = Cache()) {
+    return Memoized<Cache, F>(std::move(function), std::move(cache));
+}
+
+#endif // MEMOIZE_H
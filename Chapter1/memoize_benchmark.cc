@@ -0,0 +1,118 @@
+/**
+ * @file memoize_benchmark.cc
+ * @brief A program that compares the memoize cache backends on two workloads.
+ * @details The dense workload evaluates the fib4 recursion from an empty cache, so every key is a small consecutive integer. The sparse workload computes Collatz total stopping times recursively for every start below 2^20, which visits keys far above the starting range. For each backend the program prints the time per top-level call together with the hit and miss counts.
+ * @copyright Copyright 2023 Kyungwon Chun
+ * 
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "benchmark.h"
+#include "memoize.h"
+
+/**
+ * @brief The fib4 recursion, usable with any cache backend.
+ */
+auto fibonacci = [](auto& self, std::uint64_t n) -> std::uint64_t {
+    return n < 2 ? n : self(n - 2) + self(n - 1);
+};
+
+/**
+ * @brief The number of Collatz steps needed to reach 1 from n.
+ */
+auto collatz = [](auto& self, std::uint64_t n) -> std::uint32_t {
+    if (n == 1)
+        return 0;
+    return 1 + self(n % 2 == 0 ? n / 2 : 3 * n + 1);
+};
+
+/**
+ * @brief Prints one row of results.
+ * 
+ * @param name The name of the backend.
+ * @param seconds The time per top-level call in seconds.
+ * @param stats The hit and miss counters of the last run.
+ * @param checksum A value derived from the results, identical for every backend.
+ */
+void print_row(const std::string& name, double seconds, const CacheStats& stats, std::uint64_t checksum) {
+    std::cout << std::setw(10) << name << std::fixed << std::setprecision(1) << std::setw(14) << seconds * 1e9
+              << std::setw(12) << stats.hits << std::setw(12) << stats.misses << std::setprecision(3)
+              << std::setw(10) << stats.hit_rate() << std::setw(22) << checksum << std::endl;
+}
+
+/**
+ * @brief Times the dense Fibonacci workload with one backend.
+ * 
+ * @tparam Cache The cache backend.
+ * @param name The name of the backend.
+ * @param cache An empty cache.
+ */
+template <typename Cache>
+void run_fibonacci(const std::string& name, Cache cache) {
+    auto fib = memoize<Cache>(fibonacci, cache);
+    std::uint64_t result = 0;
+    double seconds = seconds_per_call([&] {
+        fib.clear();
+        result = fib(90);
+        do_not_optimize(result);
+    });
+    print_row(name, seconds, fib.stats(), result);
+}
+
+/**
+ * @brief Times the sparse Collatz workload with one backend.
+ * 
+ * @tparam Cache The cache backend.
+ * @param name The name of the backend.
+ * @param cache An empty cache.
+ */
+template <typename Cache>
+void run_collatz(const std::string& name, Cache cache) {
+    constexpr std::uint64_t starts = 1 << 20;
+    auto steps = memoize<Cache>(collatz, cache);
+    std::uint64_t checksum = 0;
+    Stopwatch watch;
+    for (std::uint64_t n = 1; n < starts; ++n)
+        checksum += steps(n);
+    print_row(name, watch.seconds() / starts, steps.stats(), checksum);
+}
+
+/**
+ * @brief The main function that runs both workloads with every backend.
+ * 
+ * @param argc The number of command-line arguments provided.
+ * @param argv An array of strings containing the command-line arguments.
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    std::cout << std::setw(10) << "backend" << std::setw(14) << "ns/call" << std::setw(12) << "hits"
+              << std::setw(12) << "misses" << std::setw(10) << "hit rate" << std::setw(22) << "result" << std::endl;
+
+    std::cout << "fib(90), empty cache" << std::endl;
+    run_fibonacci("hash", FlatHashCache<std::uint64_t, std::uint64_t>());
+    run_fibonacci("lru", LruCache<std::uint64_t, std::uint64_t>(128));
+    run_fibonacci("direct", DirectCache<std::uint64_t, std::uint64_t>(128));
+
+    std::cout << "collatz steps for n < 2^20" << std::endl;
+    run_collatz("hash", FlatHashCache<std::uint64_t, std::uint32_t>());
+    run_collatz("lru", LruCache<std::uint64_t, std::uint32_t>(1 << 16));
+    run_collatz("direct", DirectCache<std::uint64_t, std::uint32_t>(1 << 20));
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,208 @@
+/**
+ * @file packed_gene.cc
+ * @brief A program that compares the flat packed gene with CompressedGene2 in size and speed.
+ * @details Usage: packed_gene [bases]. The program encodes and decodes a random gene of the given length (2^26
+ * bases by default) with CompressedGene2<int>, with PackedGene and with every packing kernel the CPU supports on
+ * its own, checks that all of them round-trip and agree and that every kernel rejects stray characters, and
+ * prints the bytes per base and the encode and decode throughput in gigabytes of ASCII bases per second. It
+ * then checks the streaming paths, decoding ranges into caller buffers, iterating, printing and comparing, and
+ * times them against decompress, which allocates the whole gene.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "packed_gene.h"
+#include "trivial_compression.h"
+
+/**
+ * @brief Prints one row of the comparison.
+ */
+void print_row(const std::string& name, std::size_t bases, std::size_t bytes, double encode_seconds,
+               double decode_seconds) {
+    std::cout << std::setw(20) << name << std::fixed << std::setprecision(4) << std::setw(12)
+              << double(bytes) / bases << std::setprecision(3) << std::setw(12) << bases / encode_seconds / 1e9
+              << std::setw(12) << bases / decode_seconds / 1e9 << std::defaultfloat << std::endl;
+}
+
+/**
+ * @brief Checks that a kernel encodes like the scalar kernel and rejects stray characters anywhere in a word.
+ */
+bool verify_kernel(GeneKernel kernel, std::mt19937_64& rng) {
+    std::string chars(4 * packed_bases_per_word, 'A');
+    for (char& c : chars)
+        c = "ACGT"[rng() & 3];
+    std::uint64_t expected[4], words[4];
+    bool valid = gene_encode_scalar(chars.data(), 4, expected) && gene_encode(chars.data(), 4, words, kernel) &&
+                 std::equal(words, words + 4, expected);
+    std::string decoded(chars.size(), '\0');
+    gene_decode(words, 4, decoded.data(), kernel);
+    valid = valid && decoded == chars;
+    for (char stray : {'\0', 'a', 'c', 'g', 't', 'N', 'U', '0', '@', 'Q', 'W', '\x81', '\xC1', '\xFF'}) {
+        for (std::size_t i = 0; i < chars.size(); ++i) {
+            std::string bad = chars;
+            bad[i] = stray;
+            valid = valid && !gene_encode(bad.data(), 4, words, kernel);
+        }
+    }
+    return valid;
+}
+
+/**
+ * @brief Checks decompress_into on ranges, the iterators, printing and comparison against the original bases.
+ */
+bool verify_streaming(const std::string& original, std::mt19937_64& rng) {
+    const std::string_view prefix = std::string_view(original).substr(0, std::min<std::size_t>(original.size(), 5000));
+    const PackedGene packed(prefix);
+    const CompressedGene2<int> compressed{std::string(prefix)};
+    bool valid = packed == prefix && compressed == prefix && std::equal(prefix.begin(), prefix.end(), packed.begin()) &&
+                 std::equal(prefix.begin(), prefix.end(), compressed.begin());
+    std::ostringstream packed_text, compressed_text;
+    packed_text << packed;
+    compressed_text << compressed;
+    valid = valid && packed_text.str() == prefix && compressed_text.str() == prefix;
+    for (int trial = 0; trial < 1000 && !prefix.empty(); ++trial) {
+        std::size_t first = rng() % prefix.size(), length = rng() % 100;
+        char buffer[100];
+        std::size_t count = packed.decompress_into(std::span<char>(buffer, length), first);
+        valid = valid && count == std::min(length, prefix.size() - first) &&
+                prefix.substr(first, count) == std::string_view(buffer, count);
+    }
+    if (!prefix.empty()) {
+        std::string changed(prefix);
+        changed.back() = changed.back() == 'A' ? 'C' : 'A';
+        valid = valid && !(packed == changed) && !(compressed == changed);
+    }
+    return valid;
+}
+
+/**
+ * @brief The main function that compares the two representations.
+ *
+ * @param argc The number of command-line arguments provided.
+ * @param argv An array of strings containing the command-line arguments.
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    std::size_t bases = argc > 1 ? std::stoull(argv[1]) : std::size_t(1) << 26;
+
+    std::mt19937_64 rng(2023);
+    std::string original(bases, 'A');
+    for (char& base : original)
+        base = "ACGT"[rng() & 3];
+
+    bool valid = true;
+    PackedGene pieces;
+    for (std::size_t i = 0; i < std::min<std::size_t>(bases, 100000);) {
+        std::size_t length = std::min<std::size_t>(rng() % 100, bases - i);
+        pieces.append(std::string_view(original).substr(i, length));
+        i += length;
+    }
+    valid = valid && pieces == PackedGene(std::string_view(original).substr(0, pieces.size()));
+    for (int i = 0; i < 1000 && bases > 0; ++i) {
+        std::size_t index = rng() % pieces.size();
+        valid = valid && pieces[index] == original[index];
+    }
+    try {
+        PackedGene("ACGTACGTACGTACGTACGTACGTACGTACGTACGTN");
+        valid = false;
+    } catch (const std::invalid_argument&) {
+    }
+
+    std::cout << std::setw(20) << "representation" << std::setw(12) << "bytes/base" << std::setw(12)
+              << "encode GB/s" << std::setw(12) << "decode GB/s" << std::endl;
+    {
+        Stopwatch watch;
+        CompressedGene2<int> compressed(original);
+        double encode_seconds = watch.seconds();
+        watch.reset();
+        std::string decompressed = compressed.decompress();
+        double decode_seconds = watch.seconds();
+        valid = valid && decompressed == original;
+        print_row("CompressedGene2<int>", bases, compressed.bit_length() / 8, encode_seconds, decode_seconds);
+    }
+    {
+        double encode_seconds = 1e300, decode_seconds = 1e300;
+        std::size_t bytes = 0;
+        for (int run = 0; run < 5; ++run) {
+            Stopwatch watch;
+            PackedGene packed(original);
+            encode_seconds = std::min(encode_seconds, watch.seconds());
+            watch.reset();
+            std::string decompressed = packed.decompress();
+            decode_seconds = std::min(decode_seconds, watch.seconds());
+            valid = valid && decompressed == original;
+            bytes = packed.bytes();
+        }
+        print_row("PackedGene", bases, bytes, encode_seconds, decode_seconds);
+    }
+
+    const std::size_t words = bases / packed_bases_per_word;
+    std::vector<std::uint64_t> expected(words);
+    valid = gene_encode_scalar(original.data(), words, expected.data()) && valid;
+    for (GeneKernel kernel : {GeneKernel::scalar, GeneKernel::sse41, GeneKernel::avx2}) {
+        if (!gene_kernel_supported(kernel))
+            continue;
+        valid = verify_kernel(kernel, rng) && valid;
+        std::vector<std::uint64_t> packed(words);
+        std::string decompressed(words * packed_bases_per_word, '\0');
+        double encode_seconds = 1e300, decode_seconds = 1e300;
+        for (int run = 0; run < 5; ++run) {
+            Stopwatch watch;
+            valid = gene_encode(original.data(), words, packed.data(), kernel) && valid;
+            encode_seconds = std::min(encode_seconds, watch.seconds());
+            watch.reset();
+            gene_decode(packed.data(), words, decompressed.data(), kernel);
+            decode_seconds = std::min(decode_seconds, watch.seconds());
+        }
+        valid = valid && packed == expected && decompressed == original.substr(0, decompressed.size());
+        print_row(std::string("kernel ") + to_string(kernel), words * packed_bases_per_word,
+                  words * sizeof(std::uint64_t), encode_seconds, decode_seconds);
+    }
+
+    std::cout << "best kernel: " << to_string(best_gene_kernel()) << std::endl;
+
+    valid = verify_streaming(original, rng) && valid;
+    const PackedGene packed(original);
+    std::string buffer(bases, '\0');
+    std::cout << std::endl << std::setw(20) << "PackedGene path" << std::setw(12) << "GB/s" << std::endl;
+    auto time_path = [&](const std::string& name, auto&& path) {
+        double seconds = 1e300;
+        for (int run = 0; run < 5; ++run) {
+            Stopwatch watch;
+            valid = path() && valid;
+            seconds = std::min(seconds, watch.seconds());
+        }
+        std::cout << std::setw(20) << name << std::fixed << std::setprecision(3) << std::setw(12)
+                  << bases / seconds / 1e9 << std::defaultfloat << std::endl;
+    };
+    time_path("decompress", [&] { return packed.decompress() == original; });
+    time_path("decompress_into", [&] { return packed.decompress_into(buffer) == bases; });
+    time_path("operator==", [&] { return packed == original; });
+    time_path("iterator", [&] { return std::equal(original.begin(), original.end(), packed.begin()); });
+    std::cout << "round trips and invalid input: " << (valid ? "ok" : "FAILED") << std::endl;
+    return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,278 @@
+/**
+ * @file packed_gene.h
+ * @brief A gene stored as a flat vector of 64-bit words, 32 nucleotides of 2 bits each.
+ * @details Base i lives in bits 2 (i % 32) and 2 (i % 32) + 1 of word i / 32, with the codes A = 00, C = 01,
+ * G = 10 and T = 11 of CompressedGene. The length is kept apart, so no bit is spent on a sentinel or padding
+ * except in the unused tail of the last word, which stays zero.
+ *
+ * Whole words are encoded and decoded by the kernels of gene_simd.h, picked at runtime; the bases that do not
+ * fill a word are padded with A. Any range of bases decodes into a caller buffer, and printing and comparing
+ * go through a small fixed buffer, so even a multi-gigabase gene is never copied whole.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PACKED_GENE_H
+#define PACKED_GENE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gene_simd.h"
+
+inline constexpr std::size_t packed_stream_buffer = 4096;
+
+/**
+ * @brief Throws for the first character of a string that is not A, C, G or T, if any.
+ */
+inline void check_nucleotides(std::string_view gene) {
+    for (char c : gene) {
+        if (c != 'A' && c != 'C' && c != 'G' && c != 'T')
+            throw std::invalid_argument("Invalid Nucleotide: " + std::string(1, c));
+    }
+}
+
+/**
+ * @brief A nucleotide sequence packed 32 bases to a 64-bit word.
+ */
+class PackedGene {
+public:
+    /**
+     * @brief Constructs an empty gene.
+     */
+    PackedGene() = default;
+
+    /**
+     * @brief Constructs a gene from a string of A, C, G and T.
+     *
+     * @throws std::invalid_argument If a character is not A, C, G or T.
+     */
+    explicit PackedGene(std::string_view gene) {
+        append(gene);
+    }
+
+    /**
+     * @brief Appends bases, whole words at a time once the last word is full.
+     *
+     * @param gene The bases, A, C, G or T.
+     * @throws std::invalid_argument If a character is not A, C, G or T; the gene then keeps a prefix of the bases.
+     */
+    void append(std::string_view gene) {
+        std::size_t i = 0;
+        for (; i < gene.size() && _length % packed_bases_per_word != 0; ++i)
+            push_back(gene[i]);
+        const std::size_t full = (gene.size() - i) / packed_bases_per_word, first = _words.size();
+        _words.resize(first + full);
+        if (!gene_encode(gene.data() + i, full, _words.data() + first)) {
+            _words.resize(first);
+            check_nucleotides(gene.substr(i, full * packed_bases_per_word));
+        }
+        i += full * packed_bases_per_word;
+        _length += full * packed_bases_per_word;
+        if (i < gene.size()) {
+            char tail[packed_bases_per_word];
+            std::memset(tail, 'A', packed_bases_per_word);
+            std::memcpy(tail, gene.data() + i, gene.size() - i);
+            std::uint64_t word;
+            if (!gene_encode(tail, 1, &word))
+                check_nucleotides(gene.substr(i));
+            _words.push_back(word);
+            _length += gene.size() - i;
+        }
+    }
+
+    /**
+     * @brief Appends one base.
+     *
+     * @throws std::invalid_argument If the character is not A, C, G or T.
+     */
+    void push_back(char base) {
+        const std::uint64_t chars = 0x41 * (packed_low_bytes << 8) | static_cast<unsigned char>(base);  // then seven As
+        const std::uint64_t code = packed_codes_of_chars(chars);
+        if (packed_chars_of_codes(code) != chars)
+            check_nucleotides(std::string_view(&base, 1));
+        if (_length % packed_bases_per_word == 0)
+            _words.push_back(0);
+        _words.back() |= code << (2 * (_length % packed_bases_per_word));
+        ++_length;
+    }
+
+    /**
+     * @brief Returns the number of bases.
+     */
+    std::size_t size() const {
+        return _length;
+    }
+
+    /**
+     * @brief Returns the base at an index.
+     */
+    char operator[](std::size_t index) const {
+        const std::uint64_t word = _words[index / packed_bases_per_word];
+        return "ACGT"[(word >> (2 * (index % packed_bases_per_word))) & 3];
+    }
+
+    /**
+     * @brief Returns the packed words; the bits past the last base are zero.
+     */
+    std::span<const std::uint64_t> words() const {
+        return _words;
+    }
+
+    /**
+     * @brief Returns the number of bytes of the packed words.
+     */
+    std::size_t bytes() const {
+        return _words.size() * sizeof(std::uint64_t);
+    }
+
+    /**
+     * @brief A forward iterator over the bases that decodes them on the fly.
+     */
+    class const_iterator {
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = char;
+        using difference_type = std::ptrdiff_t;
+
+        const_iterator() = default;
+
+        const_iterator(const std::uint64_t* words, std::size_t index) : _words(words), _index(index) {}
+
+        char operator*() const {
+            const std::uint64_t word = _words[_index / packed_bases_per_word];
+            return "ACGT"[(word >> (2 * (_index % packed_bases_per_word))) & 3];
+        }
+
+        const_iterator& operator++() {
+            ++_index;
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++_index;
+            return old;
+        }
+
+        bool operator==(const const_iterator& other) const = default;
+
+    private:
+        const std::uint64_t* _words = nullptr;
+        std::size_t _index = 0;
+    };
+
+    /**
+     * @brief Returns an iterator to the first base.
+     */
+    const_iterator begin() const {
+        return const_iterator(_words.data(), 0);
+    }
+
+    /**
+     * @brief Returns an iterator past the last base.
+     */
+    const_iterator end() const {
+        return const_iterator(_words.data(), _length);
+    }
+
+    /**
+     * @brief Decodes bases into a caller buffer without allocating.
+     *
+     * @param out The buffer.
+     * @param first The index of the first base to decode.
+     * @return std::size_t The number of bases written, the smaller of out.size() and size() - first.
+     * @throws std::out_of_range If first is past the last base.
+     */
+    std::size_t decompress_into(std::span<char> out, std::size_t first = 0) const {
+        if (first > _length)
+            throw std::out_of_range("The first base is past the end of the gene");
+        const std::size_t count = std::min(out.size(), _length - first);
+        for (std::size_t done = 0; done < count;) {
+            const std::size_t index = first + done, w = index / packed_bases_per_word;
+            const std::size_t offset = index % packed_bases_per_word;
+            if (offset == 0 && count - done >= packed_bases_per_word) {
+                const std::size_t full = (count - done) / packed_bases_per_word;
+                gene_decode(_words.data() + w, full, out.data() + done);
+                done += full * packed_bases_per_word;
+            } else {  // a partial word at either end
+                char word[packed_bases_per_word];
+                gene_decode(_words.data() + w, 1, word);
+                const std::size_t n = std::min(packed_bases_per_word - offset, count - done);
+                std::memcpy(out.data() + done, word + offset, n);
+                done += n;
+            }
+        }
+        return count;
+    }
+
+    /**
+     * @brief Decodes all bases into a string.
+     */
+    std::string decompress() const {
+        std::string gene(_length, '\0');
+        decompress_into(gene);
+        return gene;
+    }
+
+    /**
+     * @brief Writes the bases to a stream through a fixed buffer, without decompressing the whole gene.
+     */
+    void print(std::ostream& out) const {
+        char buffer[packed_stream_buffer];
+        for (std::size_t first = 0; first < _length; first += packed_stream_buffer)
+            out.write(buffer, static_cast<std::streamsize>(decompress_into(buffer, first)));
+    }
+
+    /**
+     * @brief Compares the bases with a string, decoding them a buffer at a time.
+     */
+    friend bool operator==(const PackedGene& gene, std::string_view bases) {
+        if (gene.size() != bases.size())
+            return false;
+        char buffer[packed_stream_buffer];
+        for (std::size_t first = 0; first < gene.size(); first += packed_stream_buffer) {
+            const std::size_t count = gene.decompress_into(buffer, first);
+            if (std::memcmp(buffer, bases.data() + first, count) != 0)
+                return false;
+        }
+        return true;
+    }
+
+    bool operator==(const PackedGene& other) const = default;
+
+private:
+    std::vector<std::uint64_t> _words;
+    std::size_t _length = 0;
+};
+
+/**
+ * @brief Prints the bases of a packed gene.
+ */
+inline std::ostream& operator<<(std::ostream& out, const PackedGene& gene) {
+    gene.print(out);
+    return out;
+}
+
+#endif // PACKED_GENE_H
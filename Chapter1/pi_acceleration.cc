@@ -0,0 +1,94 @@
+/**
+ * @file pi_acceleration.cc
+ * @brief A program that measures digits of pi against wall time for accelerated and alternative series.
+ * @details For every method the program doubles the number of terms until double precision is exhausted and
+ * prints one line per run with the method, the number of terms, the time per evaluation and the number of
+ * correct decimal digits. The output is whitespace separated, so it can be plotted directly, e.g. in gnuplot
+ * with the time on a logarithmic x axis and one curve per method. The plain Leibniz sum (vectorized, from
+ * pi_simd.h) is the baseline.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <numbers>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "pi_acceleration.h"
+#include "pi_simd.h"
+
+/**
+ * @brief A named way of calculating pi from a number of terms.
+ */
+struct Method {
+    std::string name;
+    std::function<double(std::size_t)> pi;
+    std::size_t max_terms;
+};
+
+/**
+ * @brief Returns the number of correct decimal digits of an approximation of pi, at most 16.
+ *
+ * @param value The approximation.
+ * @return double The number of digits.
+ */
+double correct_digits(double value) {
+    double error = std::abs(value - std::numbers::pi);
+    return error == 0 ? 16.0 : std::min(16.0, -std::log10(error / std::numbers::pi));
+}
+
+/**
+ * @brief The main function that prints the digits against time for every method.
+ *
+ * @param argc The number of command-line arguments provided.
+ * @param argv An array of strings containing the command-line arguments.
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    std::vector<Method> methods = {
+        {"leibniz", [](std::size_t n) { return calculate_pi_simd(n); }, std::size_t(1) << 30},
+        {EulerTransform::name, [](std::size_t n) { return accelerated_pi<EulerTransform>(n); }, 1024},
+        {AitkenDeltaSquared::name, [](std::size_t n) { return accelerated_pi<AitkenDeltaSquared>(n); }, 1024},
+        {RichardsonExtrapolation::name,
+         [](std::size_t n) { return accelerated_pi<RichardsonExtrapolation>(n); }, 1024},
+        {"machin", [](std::size_t n) { return machin_like_pi(machin_formula, n); }, 1024},
+        {"stormer", [](std::size_t n) { return machin_like_pi(stormer_formula, n); }, 1024},
+    };
+
+    std::cout << "# " << std::setw(10) << "method" << std::setw(12) << "terms" << std::setw(14) << "seconds"
+              << std::setw(10) << "digits" << std::endl;
+    for (const Method& method : methods) {
+        for (std::size_t n = 2; n <= method.max_terms; n *= 2) {
+            double value = method.pi(n);
+            double seconds = seconds_per_call([&] { do_not_optimize(method.pi(n)); }, 0.01);
+            double digits = correct_digits(value);
+            std::cout << "  " << std::setw(10) << method.name << std::setw(12) << n << std::setw(14)
+                      << std::scientific << std::setprecision(3) << seconds << std::defaultfloat << std::setw(10)
+                      << std::fixed << std::setprecision(2) << digits << std::defaultfloat << std::endl;
+            if (digits >= 15)
+                break;
+        }
+        std::cout << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
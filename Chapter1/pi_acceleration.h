@@ -0,0 +1,197 @@
+/**
+ * @file pi_acceleration.h
+ * @brief Series acceleration of the Leibniz series and faster arctangent series for pi.
+ * @details The Leibniz partial sums S_n approach pi with an error of about 1/n, so every further digit costs ten
+ * times as many terms. An accelerator maps a short run of partial sums S_1, ..., S_n to a much better estimate
+ * of their limit. Any callable taking std::span<const double> and returning double can be plugged into
+ * accelerated_pi; three are provided:
+ *  - EulerTransform, the Euler transform of an alternating series in van Wijngaarden's form (repeated
+ *    averaging of neighbouring partial sums), which gains about log10(2) digits per term.
+ *  - AitkenDeltaSquared, Aitken's delta-squared process applied until one value remains.
+ *  - RichardsonExtrapolation, which combines S_n, S_{n/2}, S_{n/4}, ... to cancel the powers of 1/n in the error.
+ * machin_like_pi evaluates the other route, pi as a sum of arctangents of small reciprocals, e.g. Machin's
+ * formula pi = 16 arctan(1/5) - 4 arctan(1/239).
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PI_ACCELERATION_H
+#define PI_ACCELERATION_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief Returns the partial sums S_1, ..., S_n of the Leibniz series, where S_k adds the first k terms.
+ *
+ * @param n The number of partial sums.
+ * @return std::vector<double> The partial sums.
+ */
+inline std::vector<double> leibniz_partial_sums(std::size_t n) {
+    std::vector<double> sums(n);
+    double sum = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        sum += (i % 2 == 0 ? 4.0 : -4.0) / (2.0 * double(i) + 1.0);
+        sums[i] = sum;
+    }
+    return sums;
+}
+
+/**
+ * @brief The Euler transform in van Wijngaarden's form.
+ * @details Replacing the partial sums by the means of neighbours n - 1 times leaves one value, which equals the
+ * Euler transform of the series truncated after n terms.
+ */
+struct EulerTransform {
+    static constexpr const char* name = "euler";
+
+    double operator()(std::span<const double> sums) const {
+        if (sums.empty())
+            throw std::invalid_argument("EulerTransform needs at least one partial sum");
+        std::vector<double> s(sums.begin(), sums.end());
+        for (std::size_t length = s.size(); length > 1; --length) {
+            for (std::size_t i = 0; i + 1 < length; ++i)
+                s[i] = 0.5 * (s[i] + s[i + 1]);
+        }
+        return s[0];
+    }
+};
+
+/**
+ * @brief Aitken's delta-squared process, iterated until one or two values remain.
+ * @details One pass maps s_i, s_{i+1}, s_{i+2} to s_{i+2} - (s_{i+2} - s_{i+1})^2 / (s_{i+2} - 2 s_{i+1} + s_i).
+ * Once the differences vanish in double precision the last value is kept unchanged.
+ */
+struct AitkenDeltaSquared {
+    static constexpr const char* name = "aitken";
+
+    double operator()(std::span<const double> sums) const {
+        if (sums.empty())
+            throw std::invalid_argument("AitkenDeltaSquared needs at least one partial sum");
+        std::vector<double> s(sums.begin(), sums.end());
+        std::size_t length = s.size();
+        for (; length > 2; length -= 2) {
+            for (std::size_t i = 0; i + 2 < length; ++i) {
+                double d1 = s[i + 1] - s[i];
+                double d2 = s[i + 2] - s[i + 1];
+                double denominator = d2 - d1;
+                s[i] = denominator == 0 ? s[i + 2] : s[i + 2] - d2 * d2 / denominator;
+            }
+        }
+        return s[length - 1];
+    }
+};
+
+/**
+ * @brief Richardson extrapolation over partial sums with halving term counts.
+ * @details From S_n, S_{n/2}, ..., S_{n/2^m} (all at even term counts) each column of the Romberg tableau
+ * cancels one power p of 1/n in the error with T_{j,k} = T_{j,k-1} + (T_{j,k-1} - T_{j-1,k-1}) / (2^p - 1).
+ * At even n the Leibniz error is 1/n - 1/(4n^3) + 5/(16n^5) - ..., so by default the powers are 1, 3, 5, ...
+ */
+struct RichardsonExtrapolation {
+    static constexpr const char* name = "richardson";
+
+    int first_power = 1;
+    int power_step = 2;
+
+    double operator()(std::span<const double> sums) const {
+        if (sums.size() < 2)
+            throw std::invalid_argument("RichardsonExtrapolation needs at least two partial sums");
+        std::size_t n = sums.size() & ~std::size_t(1);
+        std::size_t levels = 0;
+        while ((n >> (levels + 1)) % 2 == 0 && (n >> (levels + 1)) >= 2)
+            ++levels;
+
+        std::vector<double> previous, row;
+        for (std::size_t j = 0; j <= levels; ++j) {
+            row.assign(1, sums[(n >> (levels - j)) - 1]);
+            for (std::size_t k = 1; k <= j; ++k) {
+                double factor = std::ldexp(1.0, first_power + int(k - 1) * power_step);
+                row.push_back(row[k - 1] + (row[k - 1] - previous[k - 1]) / (factor - 1));
+            }
+            previous.swap(row);
+        }
+        return previous.back();
+    }
+};
+
+/**
+ * @brief Calculates pi from the first n_terms terms of the Leibniz series with an accelerator.
+ *
+ * @tparam Accelerator A callable mapping std::span<const double> partial sums to an estimate of their limit.
+ * @param n_terms The number of terms.
+ * @param accelerator The accelerator.
+ * @return double The calculated value of pi.
+ */
+template <typename Accelerator>
+double accelerated_pi(std::size_t n_terms, Accelerator accelerator = {}) {
+    std::vector<double> sums = leibniz_partial_sums(n_terms);
+    return accelerator(std::span<const double>(sums));
+}
+
+/**
+ * @brief One term c * arctan(1 / q) of a Machin-like formula.
+ */
+struct ArctanTerm {
+    double coefficient;
+    std::uint64_t inverse;
+};
+
+/**
+ * @brief Machin's formula, pi = 16 arctan(1/5) - 4 arctan(1/239).
+ */
+inline constexpr ArctanTerm machin_formula[] = {{16, 5}, {-4, 239}};
+
+/**
+ * @brief Størmer's formula, pi = 176 arctan(1/57) + 28 arctan(1/239) - 48 arctan(1/682) + 96 arctan(1/12943).
+ */
+inline constexpr ArctanTerm stormer_formula[] = {{176, 57}, {28, 239}, {-48, 682}, {96, 12943}};
+
+/**
+ * @brief Sums the first n_terms terms of the Taylor series of arctan(1 / q).
+ *
+ * @param q The reciprocal of the argument.
+ * @param n_terms The number of terms.
+ * @return double The partial sum.
+ */
+inline double arctan_inverse(std::uint64_t q, std::size_t n_terms) {
+    double x2 = 1.0 / (double(q) * double(q));
+    double power = 1.0 / double(q);
+    double sum = 0;
+    for (std::size_t k = 0; k < n_terms && power != 0; ++k) {
+        sum += (k % 2 == 0 ? power : -power) / double(2 * k + 1);
+        power *= x2;
+    }
+    return sum;
+}
+
+/**
+ * @brief Calculates pi with a Machin-like formula, summing n_terms terms of every arctangent series.
+ *
+ * @param formula The terms of the formula.
+ * @param n_terms The number of terms per arctangent.
+ * @return double The calculated value of pi.
+ */
+inline double machin_like_pi(std::span<const ArctanTerm> formula, std::size_t n_terms) {
+    double pi = 0;
+    for (const ArctanTerm& term : formula)
+        pi += term.coefficient * arctan_inverse(term.inverse, n_terms);
+    return pi;
+}
+
+#endif // PI_ACCELERATION_H
@@ -0,0 +1,76 @@
+/**
+ * @file pi_bbp.cc
+ * @brief A program that extracts hexadecimal digits of pi at far positions with the BBP formula.
+ * @details Usage: pi_bbp [max_position]. The program prints eight hex digits and the latency of a single
+ * extraction at positions 10^6, 10^7, ... up to max_position (10^8 by default), then times a batch of positions
+ * on a growing number of threads.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "benchmark.h"
+#include "pi_bbp.h"
+
+/**
+ * @brief The main function that times single and batched digit extraction.
+ *
+ * @param argc The number of command-line arguments provided.
+ * @param argv An array of strings containing the command-line arguments.
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    std::uint64_t max_position = argc > 1 ? std::stoull(argv[1]) : 100000000;
+
+    std::cout << "pi = 3." << pi_hex_digits(1, 8) << pi_hex_digits(9, 8) << "... (hex)" << std::endl;
+    std::cout << std::setw(12) << "position" << std::setw(12) << "digits" << std::setw(12) << "seconds"
+              << std::endl;
+    for (std::uint64_t position = 1000000; position <= max_position; position *= 10) {
+        Stopwatch watch;
+        std::string digits = pi_hex_digits(position, 8);
+        double seconds = watch.seconds();
+        std::cout << std::setw(12) << position << std::setw(12) << digits << std::setw(12) << std::fixed
+                  << std::setprecision(3) << seconds << std::defaultfloat << std::endl;
+    }
+
+    std::vector<std::uint64_t> positions;
+    for (std::uint64_t i = 0; i < 64; ++i)
+        positions.push_back(100000 + 1000 * i);
+    unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << std::endl << "batch of " << positions.size() << " positions near 10^5" << std::endl;
+    std::cout << std::setw(12) << "threads" << std::setw(12) << "seconds" << std::setw(16) << "positions/s"
+              << std::endl;
+    for (unsigned threads = 1;; threads = std::min(2 * threads, max_threads)) {
+        Stopwatch watch;
+        std::vector<std::string> digits = pi_hex_digits_batch(positions, 8, threads);
+        double seconds = watch.seconds();
+        do_not_optimize(digits);
+        std::cout << std::setw(12) << threads << std::setw(12) << std::fixed << std::setprecision(3) << seconds
+                  << std::setw(16) << std::setprecision(1) << positions.size() / seconds << std::defaultfloat
+                  << std::endl;
+        if (threads == max_threads)
+            break;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,216 @@
+/**
+ * @file pi_bbp.h
+ * @brief Hexadecimal digits of pi at arbitrary positions with the Bailey-Borwein-Plouffe formula.
+ * @details pi = sum_k 16^-k (4 / (8k + 1) - 2 / (8k + 4) - 1 / (8k + 5) - 1 / (8k + 6)), so the fraction of
+ * 16^n pi, whose hex digits start at position n + 1, only needs the fractions of 16^(n - k) / (8k + j). For
+ * k < n these are (16^(n - k) mod (8k + j)) / (8k + j), computed with modular exponentiation; the few terms
+ * with k >= n are summed directly. Writing 8k + j = 2^s m with m odd turns every term into
+ * (2^(4(n - k) - s) mod m) / m, so all moduli are odd and Montgomery multiplication applies. The powers of two
+ * need only squarings and doublings, and the four series share an exponent, so their ladders run in lockstep.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PI_BBP_H
+#define PI_BBP_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Arithmetic modulo an odd 64-bit modulus in Montgomery form with R = 2^64.
+ */
+class Montgomery64 {
+public:
+    /**
+     * @brief Prepares the constants of a modulus.
+     *
+     * @param modulus An odd modulus below 2^63.
+     */
+    explicit Montgomery64(std::uint64_t modulus) : _m(modulus) {
+        std::uint64_t inverse = modulus;  // correct to 3 bits, since m * m = 1 mod 8 for odd m
+        for (int i = 0; i < 5; ++i)
+            inverse *= 2 - modulus * inverse;  // each step doubles the correct bits
+        _neg_inverse = -inverse;
+        _one = -modulus % modulus;  // 2^64 mod m
+    }
+
+    /**
+     * @brief Returns the modulus.
+     */
+    std::uint64_t modulus() const {
+        return _m;
+    }
+
+    /**
+     * @brief Returns 1 in Montgomery form.
+     */
+    std::uint64_t one() const {
+        return _one;
+    }
+
+    /**
+     * @brief Returns t / R mod m for t < m R.
+     */
+    std::uint64_t reduce(unsigned __int128 t) const {
+        std::uint64_t u = static_cast<std::uint64_t>(t) * _neg_inverse;
+        auto result = static_cast<std::uint64_t>((t + static_cast<unsigned __int128>(u) * _m) >> 64);
+        return result >= _m ? result - _m : result;
+    }
+
+    /**
+     * @brief Multiplies two values in Montgomery form.
+     */
+    std::uint64_t multiply(std::uint64_t a, std::uint64_t b) const {
+        return reduce(static_cast<unsigned __int128>(a) * b);
+    }
+
+    /**
+     * @brief Doubles a value; the result stays in Montgomery form.
+     */
+    std::uint64_t twice(std::uint64_t a) const {
+        a += a;
+        return a >= _m ? a - _m : a;
+    }
+
+private:
+    std::uint64_t _m;
+    std::uint64_t _neg_inverse;  // -m^-1 mod 2^64
+    std::uint64_t _one;
+};
+
+/**
+ * @brief Returns the fraction of 16^n pi, whose hex digits are those of pi from position n + 1 on.
+ * @details The result carries an absolute error of roughly sqrt(n) * 2^-53 from the double-precision sums.
+ *
+ * @param n The number of hex digits to skip.
+ * @return double The fraction, in [0, 1).
+ * @throws std::out_of_range If 8n + 6 does not fit the 63-bit moduli.
+ */
+inline double pi_bbp_fraction(std::uint64_t n) {
+    if (n > (std::uint64_t(1) << 59))
+        throw std::out_of_range("BBP position is too large");
+
+    constexpr int series = 4;
+    constexpr std::uint64_t offsets[series] = {1, 4, 5, 6};
+    constexpr int shifts[series] = {0, 2, 0, 1};  // 8k + j = 2^shift * odd
+    constexpr double weights[series] = {4, -2, -1, -1};
+    double sums[series] = {};
+
+    for (std::uint64_t k = 0; k < n; ++k) {
+        // 16^(n - k) / (2^s m) = 2^(exponent + 2 - s) / m with the common exponent 4(n - k) - 2.
+        const std::uint64_t exponent = 4 * (n - k) - 2;
+        Montgomery64 moduli[series] = {Montgomery64(8 * k + 1), Montgomery64(2 * k + 1), Montgomery64(8 * k + 5),
+                                       Montgomery64(4 * k + 3)};
+        std::uint64_t x[series];
+        for (int j = 0; j < series; ++j)
+            x[j] = moduli[j].one();
+        for (int bit = std::bit_width(exponent) - 1; bit >= 0; --bit) {
+            for (int j = 0; j < series; ++j)
+                x[j] = moduli[j].multiply(x[j], x[j]);
+            if ((exponent >> bit) & 1) {
+                for (int j = 0; j < series; ++j)
+                    x[j] = moduli[j].twice(x[j]);
+            }
+        }
+        for (int j = 0; j < series; ++j) {
+            for (int d = shifts[j]; d < 2; ++d)
+                x[j] = moduli[j].twice(x[j]);
+            double m = static_cast<double>(moduli[j].modulus());
+            sums[j] += static_cast<double>(moduli[j].reduce(x[j])) / m;
+            sums[j] -= std::floor(sums[j]);
+        }
+    }
+
+    for (std::uint64_t k = n;; ++k) {  // terms with k >= n are below 1 and shrink by 16 each
+        double scale = std::ldexp(1.0, -4 * static_cast<int>(k - n));
+        if (scale < 1e-20)
+            break;
+        for (int j = 0; j < series; ++j)
+            sums[j] += scale / static_cast<double>(8 * k + offsets[j]);
+    }
+
+    double fraction = 0;
+    for (int j = 0; j < series; ++j)
+        fraction += weights[j] * (sums[j] - std::floor(sums[j]));
+    return fraction - std::floor(fraction);
+}
+
+/**
+ * @brief Returns hex digits of pi starting at a position after the point.
+ * @details Position 1 is the first digit after the point, so pi_hex_digits(1, 8) is "243F6A88". About eight
+ * digits are reliable up to position 10^8, fewer beyond.
+ *
+ * @param position The position of the first digit, at least 1.
+ * @param count The number of digits, at most 8.
+ * @return std::string The digits in upper case.
+ * @throws std::invalid_argument If the position is 0 or count is not in [1, 8].
+ */
+inline std::string pi_hex_digits(std::uint64_t position, int count = 1) {
+    if (position == 0)
+        throw std::invalid_argument("Hex digit positions start at 1");
+    if (count < 1 || count > 8)
+        throw std::invalid_argument("Between 1 and 8 hex digits can be extracted");
+
+    double fraction = pi_bbp_fraction(position - 1);
+    std::string digits;
+    for (int i = 0; i < count; ++i) {
+        fraction *= 16;
+        int digit = static_cast<int>(fraction);
+        fraction -= digit;
+        digits.push_back("0123456789ABCDEF"[digit]);
+    }
+    return digits;
+}
+
+/**
+ * @brief Extracts the hex digits at many positions, one position per task on several threads.
+ *
+ * @param positions The positions, each at least 1.
+ * @param count The number of digits per position, at most 8.
+ * @param threads The number of threads; 0 means one per hardware thread.
+ * @return std::vector<std::string> The digits at every position, in the order of positions.
+ */
+inline std::vector<std::string> pi_hex_digits_batch(std::span<const std::uint64_t> positions, int count = 1,
+                                                    unsigned threads = 0) {
+    std::vector<std::string> results(positions.size());
+    std::atomic<std::size_t> next{0};
+    auto worker = [&] {
+        for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < positions.size();)
+            results[i] = pi_hex_digits(positions[i], count);
+    };
+
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, positions.size()));
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; ++t)
+        workers.emplace_back(worker);
+    if (threads > 0)
+        worker();
+    for (std::thread& w : workers)
+        w.join();
+    return results;
+}
+
+#endif // PI_BBP_H
@@ -0,0 +1,87 @@
+/**
+ * @file pi_chudnovsky.cc
+ * @brief A program that computes pi to millions of digits with the Chudnovsky series and writes them to a file.
+ * @details Usage: pi_chudnovsky [digits] [file]. With a digit count the program writes pi with that many
+ * digits after the point to the file (pi.txt by default); without arguments it does so for 10^4, 10^5 and 10^6
+ * digits. For every run it reports the time of the binary splitting, the square root, the final division and
+ * the output, the seconds per million digits and the peak resident memory of the process so far.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "pi_chudnovsky.h"
+
+/**
+ * @brief Computes pi, writes it to a file and prints one row of results.
+ *
+ * @param digits The number of digits after the decimal point.
+ * @param path The output file.
+ * @return bool True if the file was written.
+ */
+bool run(std::size_t digits, const std::string& path) {
+    Stopwatch total;
+    Chudnovsky pi(digits);
+
+    Stopwatch watch;
+    std::ofstream file(path, std::ios::binary);
+    pi.write(file);
+    file.put('\n');
+    file.close();
+    double write_seconds = watch.seconds();
+    double seconds = total.seconds();
+
+    const ChudnovskyStats& stats = pi.stats();
+    std::cout << std::setw(10) << digits << std::setw(9) << stats.terms << std::fixed << std::setprecision(3)
+              << std::setw(10) << stats.split_seconds << std::setw(10) << stats.sqrt_seconds << std::setw(10)
+              << stats.divide_seconds << std::setw(10) << write_seconds << std::setw(10) << seconds
+              << std::setw(12) << seconds / (digits / 1e6) << std::setw(12) << std::setprecision(1)
+              << process_memory_bytes("VmHWM") / 1048576.0 << std::defaultfloat << std::endl;
+    return bool(file);
+}
+
+/**
+ * @brief The main function that runs one or several digit counts.
+ *
+ * @param argc The number of command-line arguments provided.
+ * @param argv An array of strings containing the command-line arguments.
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    std::vector<std::size_t> digit_counts = {10000, 100000, 1000000};
+    if (argc > 1)
+        digit_counts = {std::stoull(argv[1])};
+    std::string path = argc > 2 ? argv[2] : "pi.txt";
+
+    std::cout << std::setw(10) << "digits" << std::setw(9) << "terms" << std::setw(10) << "split s"
+              << std::setw(10) << "sqrt s" << std::setw(10) << "divide s" << std::setw(10) << "write s"
+              << std::setw(10) << "total s" << std::setw(12) << "s/Mdigit" << std::setw(12) << "peak MiB"
+              << std::endl;
+    for (std::size_t digits : digit_counts) {
+        if (!run(digits, path)) {
+            std::cerr << "Cannot write " << path << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::cout << "digits written to " << path << std::endl;
+    return EXIT_SUCCESS;
+}
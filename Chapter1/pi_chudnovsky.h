@@ -0,0 +1,291 @@
+/**
+ * @file pi_chudnovsky.h
+ * @brief Pi to millions of decimal digits with the Chudnovsky series and binary splitting.
+ * @details The Chudnovsky series
+ *   1 / pi = 12 sum_k (-1)^k (6k)! (13591409 + 545140134 k) / ((3k)! (k!)^3 640320^(3k + 3/2))
+ * gains about 14.18 digits per term. Binary splitting evaluates n terms as three big integers P, Q and T, with
+ * pi = 426880 sqrt(10005) Q / T, by recursively merging halves of the index range; the merges near the root
+ * are the large products, so the recursion spawns its halves on the work-stealing scheduler of
+ * work_stealing.h, and the products themselves use the NTT of big_unsigned.h. All numbers are kept in base
+ * 10^8, so the result is a fixed-point decimal number whose limbs can be written out directly.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PI_CHUDNOVSKY_H
+#define PI_CHUDNOVSKY_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "big_unsigned.h"
+#include "work_stealing.h"
+
+/**
+ * @brief The binary-splitting terms P(a, b), Q(a, b) and T(a, b) of the Chudnovsky series.
+ * @details P and Q are positive; the sign (-1)^k of every term is folded into T, which may be negative.
+ */
+struct ChudnovskyTerms {
+    BigUnsigned<DecimalRadix> p;
+    BigUnsigned<DecimalRadix> q;
+    BigUnsigned<DecimalRadix> t;
+    bool t_negative = false;
+};
+
+/**
+ * @brief Intermediate timings and sizes of a Chudnovsky computation.
+ */
+struct ChudnovskyStats {
+    std::uint64_t terms = 0;
+    double split_seconds = 0;
+    double sqrt_seconds = 0;
+    double divide_seconds = 0;
+};
+
+/**
+ * @brief Evaluates pi to a number of decimal digits.
+ */
+class Chudnovsky {
+public:
+    using Decimal = BigUnsigned<DecimalRadix>;
+
+    /**
+     * @brief The number of digits each term of the series contributes, log10(640320^3 / 1728).
+     */
+    static constexpr double digits_per_term = 14.181647462725477;
+
+    /**
+     * @brief Index ranges at least this long spawn their left half as a task.
+     */
+    static constexpr std::uint64_t parallel_terms = 64;
+
+    /**
+     * @brief Extra limbs carried below the requested precision to absorb rounding.
+     */
+    static constexpr std::size_t guard_limbs = 2;
+
+    /**
+     * @brief Computes pi with a given number of decimal digits after the point.
+     *
+     * @param digits The number of digits after the decimal point.
+     * @param workers The number of worker threads of the splitting tree; zero means one per hardware thread.
+     */
+    explicit Chudnovsky(std::size_t digits, unsigned workers = 0) : _digits(digits) {
+        _fraction_limbs = (digits + 7) / 8 + guard_limbs;
+        _stats.terms = static_cast<std::uint64_t>(digits / digits_per_term) + 2;
+
+        auto start = std::chrono::steady_clock::now();
+        auto seconds_since = [](auto time) {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - time).count();
+        };
+        ChudnovskyTerms terms;
+        {
+            Scheduler scheduler(workers);
+            scheduler.run([&] { terms = split(0, _stats.terms, false); });
+        }
+        if (terms.t_negative || terms.t.is_zero())
+            throw std::logic_error("Chudnovsky sum must be positive");
+        _stats.split_seconds = seconds_since(start);
+
+        // Only the ratio Q / T matters, so both are cut to the working precision.
+        std::size_t working_limbs = _fraction_limbs + guard_limbs;
+        std::size_t drop = terms.t.limbs().size() > working_limbs ? terms.t.limbs().size() - working_limbs : 0;
+        Decimal q = terms.q.shifted_right(drop);
+        Decimal t = terms.t.shifted_right(drop);
+        terms = ChudnovskyTerms();
+
+        start = std::chrono::steady_clock::now();
+        Decimal root = _scaled_sqrt(10005, _fraction_limbs);  // sqrt(10005) * base^L
+        _stats.sqrt_seconds = seconds_since(start);
+
+        start = std::chrono::steady_clock::now();
+        _scaled = divide(root * q * Decimal(426880), t);  // pi * base^L
+        _stats.divide_seconds = seconds_since(start);
+    }
+
+    /**
+     * @brief Returns pi times base^fraction_limbs(), rounded down.
+     *
+     * @return const Decimal& The fixed-point value.
+     */
+    const Decimal& scaled() const {
+        return _scaled;
+    }
+
+    /**
+     * @brief Returns the number of base 10^8 limbs after the decimal point held by scaled().
+     *
+     * @return std::size_t The number of limbs.
+     */
+    std::size_t fraction_limbs() const {
+        return _fraction_limbs;
+    }
+
+    /**
+     * @brief Returns the timings of the computation.
+     *
+     * @return const ChudnovskyStats& The statistics.
+     */
+    const ChudnovskyStats& stats() const {
+        return _stats;
+    }
+
+    /**
+     * @brief Writes "3." followed by the requested digits, in chunks of a fixed-size buffer.
+     * @details The limbs are formatted straight from the fixed-point value, so no string of all digits exists.
+     *
+     * @param out The output stream.
+     * @param chunk_size The number of characters written to the stream at a time.
+     */
+    void write(std::ostream& out, std::size_t chunk_size = 1 << 20) const {
+        const std::vector<std::uint32_t>& limbs = _scaled.limbs();
+        Decimal(limbs.back()).write(out);  // the integer part fits in the top limb
+        out.put('.');
+
+        std::vector<char> buffer(std::max<std::size_t>(chunk_size, 8));
+        std::size_t used = 0;
+        std::size_t remaining = _digits;
+        for (std::size_t i = _fraction_limbs; i-- > 0 && remaining > 0;) {
+            std::uint32_t limb = limbs[i];
+            char digits[8];
+            for (int d = 7; d >= 0; --d, limb /= 10)
+                digits[d] = static_cast<char>('0' + limb % 10);
+            std::size_t count = std::min<std::size_t>(8, remaining);
+            if (used + count > buffer.size()) {
+                out.write(buffer.data(), used);
+                used = 0;
+            }
+            std::copy(digits, digits + count, buffer.data() + used);
+            used += count;
+            remaining -= count;
+        }
+        out.write(buffer.data(), used);
+    }
+
+    /**
+     * @brief Evaluates P, Q and T over the terms [a, b).
+     *
+     * @param a The first term.
+     * @param b One past the last term.
+     * @param need_p Whether P is needed; the rightmost ranges of the tree never use it.
+     * @return ChudnovskyTerms The terms.
+     */
+    static ChudnovskyTerms split(std::uint64_t a, std::uint64_t b, bool need_p = true) {
+        if (b - a == 1)
+            return _leaf(a);
+
+        std::uint64_t m = a + (b - a) / 2;
+        ChudnovskyTerms left, right;
+        if (b - a >= parallel_terms) {
+            TaskGroup group;
+            group.spawn([&] { left = split(a, m, true); });
+            right = split(m, b, need_p);
+            group.sync();
+        } else {
+            left = split(a, m, true);
+            right = split(m, b, need_p);
+        }
+
+        // T(a, b) = T(a, m) Q(m, b) + P(a, m) T(m, b)
+        ChudnovskyTerms result;
+        Decimal first, second;
+        if (b - a >= parallel_terms) {
+            TaskGroup group;
+            group.spawn([&] { first = left.t * right.q; });
+            group.spawn([&] { result.q = left.q * right.q; });
+            if (need_p)
+                group.spawn([&] { result.p = left.p * right.p; });
+            second = left.p * right.t;
+            group.sync();
+        } else {
+            first = left.t * right.q;
+            result.q = left.q * right.q;
+            if (need_p)
+                result.p = left.p * right.p;
+            second = left.p * right.t;
+        }
+
+        bool second_negative = right.t_negative;
+        if (left.t_negative == second_negative) {
+            result.t = std::move(first) + second;
+            result.t_negative = second_negative;
+        } else if (first >= second) {
+            result.t = std::move(first) - second;
+            result.t_negative = left.t_negative;
+        } else {
+            result.t = std::move(second) - first;
+            result.t_negative = second_negative;
+        }
+        return result;
+    }
+
+private:
+    /**
+     * @brief Returns sqrt(c) * base^limbs, within a few units, for a small integer c.
+     * @details Newton's iteration for y = 1 / sqrt(c), y += y (1 - c y^2) / 2, needs only multiplications and
+     * nearly doubles the number of correct limbs per step; the root is then c * y.
+     */
+    static Decimal _scaled_sqrt(std::uint32_t c, std::size_t limbs) {
+        const long double base = DecimalRadix::base;
+        std::size_t p = std::min<std::size_t>(limbs, 2);
+        Decimal y(static_cast<std::uint64_t>(std::pow(base, static_cast<long double>(p)) / std::sqrt(static_cast<long double>(c))));
+        while (p < limbs) {
+            std::size_t next = std::min(limbs, 2 * p - 1);
+            y = y.shifted_left(next - p);
+            Decimal one = Decimal(1).shifted_left(2 * next);
+            Decimal square = y * y * Decimal(c);
+            bool increase = square <= one;
+            Decimal correction = (y * (increase ? one - square : square - one)).shifted_right(2 * next);
+            correction.divide_by(2);
+            if (increase)
+                y += correction;
+            else
+                y -= correction;
+            p = next;
+        }
+        return y * Decimal(c);
+    }
+
+    /**
+     * @brief Returns the terms of the single index k.
+     */
+    static ChudnovskyTerms _leaf(std::uint64_t k) {
+        ChudnovskyTerms result;
+        if (k == 0) {
+            result.p = 1;
+            result.q = 1;
+            result.t = 13591409;
+            return result;
+        }
+        result.p = Decimal(6 * k - 5) * Decimal(2 * k - 1) * Decimal(6 * k - 1);
+        result.q = Decimal(k) * Decimal(k) * Decimal(k) * Decimal(10939058860032000ULL);  // 640320^3 / 24
+        result.t = result.p * Decimal(13591409 + 545140134 * k);
+        result.t_negative = k % 2 == 1;
+        return result;
+    }
+
+    std::size_t _digits;
+    std::size_t _fraction_limbs;
+    Decimal _scaled;
+    ChudnovskyStats _stats;
+};
+
+#endif // PI_CHUDNOVSKY_H
@@ -0,0 +1,92 @@
+/**
+ * @file pi_monte_carlo.cc
+ * @brief A program that measures the throughput of the Monte Carlo estimate of pi per kernel and per core.
+ * @details Usage: pi_monte_carlo [samples] [seed]. The program first runs every supported kernel on one thread,
+ * then the widest kernel on a growing number of threads, with 10^9 samples by default. It prints the samples per
+ * second in total and per core, the estimate and its error in units of the standard error sqrt(p (1 - p) / n)
+ * of the estimate, and checks that all runs counted the same points.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numbers>
+#include <string>
+#include <thread>
+
+#include "benchmark.h"
+#include "pi_monte_carlo.h"
+
+/**
+ * @brief Runs the estimate once and prints one row of results.
+ *
+ * @param samples The number of samples.
+ * @param seed The seed.
+ * @param threads The number of threads.
+ * @param kernel The kernel.
+ * @return MonteCarloResult The result of the run.
+ */
+MonteCarloResult run(std::uint64_t samples, std::uint64_t seed, unsigned threads, PiKernel kernel) {
+    Stopwatch watch;
+    MonteCarloResult result = monte_carlo_pi(samples, seed, threads, kernel);
+    double seconds = watch.seconds();
+
+    unsigned cores = std::min(threads, std::max(1u, std::thread::hardware_concurrency()));
+    double p = std::numbers::pi / 4;
+    double standard_error = 4 * std::sqrt(p * (1 - p) / static_cast<double>(samples));
+    std::cout << std::setw(8) << to_string(kernel) << std::setw(9) << threads << std::fixed << std::setprecision(3)
+              << std::setw(10) << seconds << std::setprecision(1) << std::setw(12) << samples / seconds / 1e6
+              << std::setw(14) << samples / seconds / 1e6 / cores << std::setprecision(8) << std::setw(14)
+              << result.estimate() << std::setprecision(2) << std::setw(10)
+              << (result.estimate() - std::numbers::pi) / standard_error << std::defaultfloat << std::endl;
+    return result;
+}
+
+/**
+ * @brief The main function that times every kernel and several thread counts.
+ *
+ * @param argc The number of command-line arguments provided.
+ * @param argv An array of strings containing the command-line arguments.
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    std::uint64_t samples = argc > 1 ? std::stoull(argv[1]) : 1000000000ULL;
+    std::uint64_t seed = argc > 2 ? std::stoull(argv[2]) : 20230101;
+    unsigned max_threads = std::max(4u, std::thread::hardware_concurrency());
+
+    std::cout << "samples: " << samples << ", seed: " << seed << std::endl;
+    std::cout << std::setw(8) << "kernel" << std::setw(9) << "threads" << std::setw(10) << "seconds"
+              << std::setw(12) << "Msamples/s" << std::setw(14) << "per core" << std::setw(14) << "estimate"
+              << std::setw(10) << "sigmas" << std::endl;
+
+    MonteCarloResult reference = run(samples, seed, 1, PiKernel::scalar);
+    bool deterministic = true;
+    for (PiKernel kernel : {PiKernel::sse2, PiKernel::avx2, PiKernel::avx512}) {
+        if (pi_kernel_supported(kernel))
+            deterministic = run(samples, seed, 1, kernel).inside == reference.inside && deterministic;
+    }
+    for (unsigned threads = 2;; threads = std::min(2 * threads, max_threads)) {
+        deterministic = run(samples, seed, threads, best_pi_kernel()).inside == reference.inside && deterministic;
+        if (threads == max_threads)
+            break;
+    }
+
+    std::cout << (deterministic ? "all runs agree" : "runs disagree") << std::endl;
+    return deterministic ? EXIT_SUCCESS : EXIT_FAILURE;
+}
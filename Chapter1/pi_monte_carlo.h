@@ -0,0 +1,410 @@
+/**
+ * @file pi_monte_carlo.h
+ * @brief A Monte Carlo estimate of pi driven by the counter-based Philox4x32-10 generator.
+ * @details Random points in the unit square fall inside the quarter disk with probability pi / 4. Philox maps a
+ * 128-bit counter and a 64-bit key to 128 random bits with ten rounds of multiplications and xors, so block i of
+ * the sample sequence is a pure function of (i, seed): threads and SIMD lanes take disjoint ranges of counters
+ * instead of sharing a generator state, and the count is the same for every kernel and number of threads.
+ *
+ * Every block yields two points with 31-bit coordinates x and y, and the point is inside if x^2 + y^2 < 2^62. The
+ * test is exact in 64-bit integers and needs no comparison: the sum stays below 2^63, so bit 62 alone tells a
+ * point outside. The vector kernels run one counter per 32-bit lane and use the 32 x 32 -> 64-bit multiply of
+ * SSE2, AVX2 and AVX-512 both for the Philox rounds and for the squares.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PI_MONTE_CARLO_H
+#define PI_MONTE_CARLO_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "pi_simd.h"
+
+/**
+ * @brief The constants of Philox4x32: the round multipliers, the Weyl increments of the key and the rounds.
+ */
+inline constexpr std::uint32_t philox_m0 = 0xD2511F53, philox_m1 = 0xCD9E8D57;
+inline constexpr std::uint32_t philox_w0 = 0x9E3779B9, philox_w1 = 0xBB67AE85;
+inline constexpr int philox_rounds = 10;
+
+/**
+ * @brief Returns the Philox4x32-10 block of a counter under a key.
+ *
+ * @param counter The counter, least significant word first.
+ * @param key The key.
+ * @return std::array<std::uint32_t, 4> The four random words.
+ */
+inline std::array<std::uint32_t, 4> philox4x32(std::array<std::uint32_t, 4> counter,
+                                               std::array<std::uint32_t, 2> key) {
+    for (int round = 0; round < philox_rounds; ++round) {
+        if (round > 0) {
+            key[0] += philox_w0;
+            key[1] += philox_w1;
+        }
+        std::uint64_t p0 = std::uint64_t(philox_m0) * counter[0];
+        std::uint64_t p1 = std::uint64_t(philox_m1) * counter[2];
+        counter = {static_cast<std::uint32_t>(p1 >> 32) ^ counter[1] ^ key[0], static_cast<std::uint32_t>(p1),
+                   static_cast<std::uint32_t>(p0 >> 32) ^ counter[3] ^ key[1], static_cast<std::uint32_t>(p0)};
+    }
+    return counter;
+}
+
+/**
+ * @brief Returns the number of the two points of a block that lie outside the quarter disk.
+ *
+ * @param block The index of the block.
+ * @param seed The seed, used as the Philox key.
+ * @param points The number of points of the block to test, 1 or 2.
+ * @return std::uint64_t The number of points outside.
+ */
+inline std::uint64_t monte_carlo_block_outside(std::uint64_t block, std::uint64_t seed, int points = 2) {
+    std::array<std::uint32_t, 4> r =
+        philox4x32({static_cast<std::uint32_t>(block), static_cast<std::uint32_t>(block >> 32), 0, 0},
+                   {static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)});
+    std::uint64_t outside = 0;
+    for (int i = 0; i < points; ++i) {
+        std::uint64_t x = r[2 * i] >> 1, y = r[2 * i + 1] >> 1;
+        outside += (x * x + y * y) >> 62;
+    }
+    return outside;
+}
+
+/**
+ * @brief Counts the points outside the quarter disk in the blocks [begin, end) one block at a time.
+ */
+inline std::uint64_t monte_carlo_outside_scalar(std::uint64_t begin, std::uint64_t end, std::uint64_t seed) {
+    std::uint64_t outside = 0;
+    for (std::uint64_t block = begin; block < end; ++block)
+        outside += monte_carlo_block_outside(block, seed);
+    return outside;
+}
+
+/**
+ * @brief Returns whether the low counter words of lanes consecutive blocks starting at block wrap around, in
+ * which case the blocks do not share their high word and are left to the scalar code.
+ */
+inline bool monte_carlo_wraps(std::uint64_t block, int lanes) {
+    return static_cast<std::uint32_t>(block) > UINT32_MAX - static_cast<std::uint32_t>(lanes - 1);
+}
+
+#ifdef PI_SIMD_X86
+
+/**
+ * @brief Runs the Philox rounds on four counters with SSE2; c[j] holds word j of every counter.
+ */
+__attribute__((target("sse2"))) inline void philox_rounds_sse2(__m128i c[4], std::uint64_t seed) {
+    const __m128i m0 = _mm_set1_epi32(static_cast<int>(philox_m0)), m1 = _mm_set1_epi32(static_cast<int>(philox_m1));
+    const __m128i low_words = _mm_set1_epi64x(0xFFFFFFFF);
+    __m128i k0 = _mm_set1_epi32(static_cast<int>(seed)), k1 = _mm_set1_epi32(static_cast<int>(seed >> 32));
+    for (int round = 0; round < philox_rounds; ++round) {
+        if (round > 0) {
+            k0 = _mm_add_epi32(k0, _mm_set1_epi32(static_cast<int>(philox_w0)));
+            k1 = _mm_add_epi32(k1, _mm_set1_epi32(static_cast<int>(philox_w1)));
+        }
+        // The multiply takes the even lanes, so the odd lanes are shifted down and multiplied separately.
+        __m128i even0 = _mm_mul_epu32(c[0], m0), odd0 = _mm_mul_epu32(_mm_srli_epi64(c[0], 32), m0);
+        __m128i even1 = _mm_mul_epu32(c[2], m1), odd1 = _mm_mul_epu32(_mm_srli_epi64(c[2], 32), m1);
+        __m128i lo0 = _mm_or_si128(_mm_and_si128(even0, low_words), _mm_slli_epi64(odd0, 32));
+        __m128i hi0 = _mm_or_si128(_mm_srli_epi64(even0, 32), _mm_andnot_si128(low_words, odd0));
+        __m128i lo1 = _mm_or_si128(_mm_and_si128(even1, low_words), _mm_slli_epi64(odd1, 32));
+        __m128i hi1 = _mm_or_si128(_mm_srli_epi64(even1, 32), _mm_andnot_si128(low_words, odd1));
+        c[0] = _mm_xor_si128(_mm_xor_si128(hi1, c[1]), k0);
+        c[1] = lo1;
+        c[2] = _mm_xor_si128(_mm_xor_si128(hi0, c[3]), k1);
+        c[3] = lo0;
+    }
+}
+
+/**
+ * @brief Returns per 64-bit lane the number of points (x, y) outside the quarter disk, from the even and the
+ * odd 32-bit lanes.
+ */
+__attribute__((target("sse2"))) inline __m128i outside_lanes_sse2(__m128i x, __m128i y) {
+    x = _mm_srli_epi32(x, 1);
+    y = _mm_srli_epi32(y, 1);
+    __m128i xo = _mm_srli_epi64(x, 32), yo = _mm_srli_epi64(y, 32);
+    __m128i even = _mm_add_epi64(_mm_mul_epu32(x, x), _mm_mul_epu32(y, y));
+    __m128i odd = _mm_add_epi64(_mm_mul_epu32(xo, xo), _mm_mul_epu32(yo, yo));
+    return _mm_add_epi64(_mm_srli_epi64(even, 62), _mm_srli_epi64(odd, 62));
+}
+
+/**
+ * @brief Counts the points outside the quarter disk in the blocks [begin, end) four blocks at a time with SSE2.
+ */
+__attribute__((target("sse2"))) inline std::uint64_t monte_carlo_outside_sse2(std::uint64_t begin, std::uint64_t end,
+                                                                              std::uint64_t seed) {
+    constexpr int lanes = 4;
+    const __m128i lane_offsets = _mm_setr_epi32(0, 1, 2, 3);
+    __m128i outside = _mm_setzero_si128();
+    std::uint64_t scalar_outside = 0;
+
+    std::uint64_t block = begin;
+    for (; block + lanes <= end; block += lanes) {
+        if (monte_carlo_wraps(block, lanes)) {
+            scalar_outside += monte_carlo_outside_scalar(block, block + lanes, seed);
+            continue;
+        }
+        __m128i c[4] = {_mm_add_epi32(_mm_set1_epi32(static_cast<int>(block)), lane_offsets),
+                        _mm_set1_epi32(static_cast<int>(block >> 32)), _mm_setzero_si128(), _mm_setzero_si128()};
+        philox_rounds_sse2(c, seed);
+        outside = _mm_add_epi64(outside, outside_lanes_sse2(c[0], c[1]));
+        outside = _mm_add_epi64(outside, outside_lanes_sse2(c[2], c[3]));
+    }
+
+    alignas(16) std::uint64_t counts[lanes / 2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(counts), outside);
+    return counts[0] + counts[1] + scalar_outside + monte_carlo_outside_scalar(block, end, seed);
+}
+
+/**
+ * @brief Runs the Philox rounds on eight counters with AVX2; c[j] holds word j of every counter.
+ */
+__attribute__((target("avx2"))) inline void philox_rounds_avx2(__m256i c[4], std::uint64_t seed) {
+    const __m256i m0 = _mm256_set1_epi32(static_cast<int>(philox_m0));
+    const __m256i m1 = _mm256_set1_epi32(static_cast<int>(philox_m1));
+    __m256i k0 = _mm256_set1_epi32(static_cast<int>(seed)), k1 = _mm256_set1_epi32(static_cast<int>(seed >> 32));
+    for (int round = 0; round < philox_rounds; ++round) {
+        if (round > 0) {
+            k0 = _mm256_add_epi32(k0, _mm256_set1_epi32(static_cast<int>(philox_w0)));
+            k1 = _mm256_add_epi32(k1, _mm256_set1_epi32(static_cast<int>(philox_w1)));
+        }
+        __m256i even0 = _mm256_mul_epu32(c[0], m0), odd0 = _mm256_mul_epu32(_mm256_srli_epi64(c[0], 32), m0);
+        __m256i even1 = _mm256_mul_epu32(c[2], m1), odd1 = _mm256_mul_epu32(_mm256_srli_epi64(c[2], 32), m1);
+        __m256i lo0 = _mm256_blend_epi32(even0, _mm256_slli_epi64(odd0, 32), 0xAA);
+        __m256i hi0 = _mm256_blend_epi32(_mm256_srli_epi64(even0, 32), odd0, 0xAA);
+        __m256i lo1 = _mm256_blend_epi32(even1, _mm256_slli_epi64(odd1, 32), 0xAA);
+        __m256i hi1 = _mm256_blend_epi32(_mm256_srli_epi64(even1, 32), odd1, 0xAA);
+        c[0] = _mm256_xor_si256(_mm256_xor_si256(hi1, c[1]), k0);
+        c[1] = lo1;
+        c[2] = _mm256_xor_si256(_mm256_xor_si256(hi0, c[3]), k1);
+        c[3] = lo0;
+    }
+}
+
+/**
+ * @brief Returns per 64-bit lane the number of points (x, y) outside the quarter disk with AVX2.
+ */
+__attribute__((target("avx2"))) inline __m256i outside_lanes_avx2(__m256i x, __m256i y) {
+    x = _mm256_srli_epi32(x, 1);
+    y = _mm256_srli_epi32(y, 1);
+    __m256i xo = _mm256_srli_epi64(x, 32), yo = _mm256_srli_epi64(y, 32);
+    __m256i even = _mm256_add_epi64(_mm256_mul_epu32(x, x), _mm256_mul_epu32(y, y));
+    __m256i odd = _mm256_add_epi64(_mm256_mul_epu32(xo, xo), _mm256_mul_epu32(yo, yo));
+    return _mm256_add_epi64(_mm256_srli_epi64(even, 62), _mm256_srli_epi64(odd, 62));
+}
+
+/**
+ * @brief Counts the points outside the quarter disk in the blocks [begin, end) eight blocks at a time with AVX2.
+ */
+__attribute__((target("avx2"))) inline std::uint64_t monte_carlo_outside_avx2(std::uint64_t begin, std::uint64_t end,
+                                                                              std::uint64_t seed) {
+    constexpr int lanes = 8;
+    const __m256i lane_offsets = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i outside = _mm256_setzero_si256();
+    std::uint64_t scalar_outside = 0;
+
+    std::uint64_t block = begin;
+    for (; block + lanes <= end; block += lanes) {
+        if (monte_carlo_wraps(block, lanes)) {
+            scalar_outside += monte_carlo_outside_scalar(block, block + lanes, seed);
+            continue;
+        }
+        __m256i c[4] = {_mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(block)), lane_offsets),
+                        _mm256_set1_epi32(static_cast<int>(block >> 32)), _mm256_setzero_si256(),
+                        _mm256_setzero_si256()};
+        philox_rounds_avx2(c, seed);
+        outside = _mm256_add_epi64(outside, outside_lanes_avx2(c[0], c[1]));
+        outside = _mm256_add_epi64(outside, outside_lanes_avx2(c[2], c[3]));
+    }
+
+    alignas(32) std::uint64_t counts[lanes / 2];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(counts), outside);
+    return counts[0] + counts[1] + counts[2] + counts[3] + scalar_outside +
+           monte_carlo_outside_scalar(block, end, seed);
+}
+
+/**
+ * @brief Runs the Philox rounds on sixteen counters with AVX-512; c[j] holds word j of every counter.
+ */
+__attribute__((target("avx512f"))) inline void philox_rounds_avx512(__m512i c[4], std::uint64_t seed) {
+    const __m512i m0 = _mm512_set1_epi32(static_cast<int>(philox_m0));
+    const __m512i m1 = _mm512_set1_epi32(static_cast<int>(philox_m1));
+    const __mmask16 odd_lanes = 0xAAAA;
+    __m512i k0 = _mm512_set1_epi32(static_cast<int>(seed)), k1 = _mm512_set1_epi32(static_cast<int>(seed >> 32));
+    for (int round = 0; round < philox_rounds; ++round) {
+        if (round > 0) {
+            k0 = _mm512_add_epi32(k0, _mm512_set1_epi32(static_cast<int>(philox_w0)));
+            k1 = _mm512_add_epi32(k1, _mm512_set1_epi32(static_cast<int>(philox_w1)));
+        }
+        __m512i even0 = _mm512_mul_epu32(c[0], m0), odd0 = _mm512_mul_epu32(_mm512_srli_epi64(c[0], 32), m0);
+        __m512i even1 = _mm512_mul_epu32(c[2], m1), odd1 = _mm512_mul_epu32(_mm512_srli_epi64(c[2], 32), m1);
+        __m512i lo0 = _mm512_mask_blend_epi32(odd_lanes, even0, _mm512_slli_epi64(odd0, 32));
+        __m512i hi0 = _mm512_mask_blend_epi32(odd_lanes, _mm512_srli_epi64(even0, 32), odd0);
+        __m512i lo1 = _mm512_mask_blend_epi32(odd_lanes, even1, _mm512_slli_epi64(odd1, 32));
+        __m512i hi1 = _mm512_mask_blend_epi32(odd_lanes, _mm512_srli_epi64(even1, 32), odd1);
+        c[0] = _mm512_ternarylogic_epi32(hi1, c[1], k0, 0x96);  // three-way xor
+        c[1] = lo1;
+        c[2] = _mm512_ternarylogic_epi32(hi0, c[3], k1, 0x96);
+        c[3] = lo0;
+    }
+}
+
+/**
+ * @brief Returns per 64-bit lane the number of points (x, y) outside the quarter disk with AVX-512.
+ */
+__attribute__((target("avx512f"))) inline __m512i outside_lanes_avx512(__m512i x, __m512i y) {
+    x = _mm512_srli_epi32(x, 1);
+    y = _mm512_srli_epi32(y, 1);
+    __m512i xo = _mm512_srli_epi64(x, 32), yo = _mm512_srli_epi64(y, 32);
+    __m512i even = _mm512_add_epi64(_mm512_mul_epu32(x, x), _mm512_mul_epu32(y, y));
+    __m512i odd = _mm512_add_epi64(_mm512_mul_epu32(xo, xo), _mm512_mul_epu32(yo, yo));
+    return _mm512_add_epi64(_mm512_srli_epi64(even, 62), _mm512_srli_epi64(odd, 62));
+}
+
+/**
+ * @brief Counts the points outside the quarter disk in the blocks [begin, end) sixteen blocks at a time with
+ * AVX-512.
+ */
+__attribute__((target("avx512f"))) inline std::uint64_t monte_carlo_outside_avx512(std::uint64_t begin,
+                                                                                   std::uint64_t end,
+                                                                                   std::uint64_t seed) {
+    constexpr int lanes = 16;
+    const __m512i lane_offsets = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    __m512i outside = _mm512_setzero_si512();
+    std::uint64_t scalar_outside = 0;
+
+    std::uint64_t block = begin;
+    for (; block + lanes <= end; block += lanes) {
+        if (monte_carlo_wraps(block, lanes)) {
+            scalar_outside += monte_carlo_outside_scalar(block, block + lanes, seed);
+            continue;
+        }
+        __m512i c[4] = {_mm512_add_epi32(_mm512_set1_epi32(static_cast<int>(block)), lane_offsets),
+                        _mm512_set1_epi32(static_cast<int>(block >> 32)), _mm512_setzero_si512(),
+                        _mm512_setzero_si512()};
+        philox_rounds_avx512(c, seed);
+        outside = _mm512_add_epi64(outside, outside_lanes_avx512(c[0], c[1]));
+        outside = _mm512_add_epi64(outside, outside_lanes_avx512(c[2], c[3]));
+    }
+
+    return _mm512_reduce_add_epi64(outside) + scalar_outside + monte_carlo_outside_scalar(block, end, seed);
+}
+
+#endif // PI_SIMD_X86
+
+/**
+ * @brief Counts the points outside the quarter disk in the blocks [begin, end) with a given kernel.
+ *
+ * @param begin The index of the first block.
+ * @param end One past the index of the last block.
+ * @param seed The seed.
+ * @param kernel The kernel; it must be supported by the running CPU.
+ * @return std::uint64_t The number of points outside, out of 2 (end - begin).
+ * @throws std::invalid_argument If the kernel is not supported.
+ */
+inline std::uint64_t monte_carlo_outside(std::uint64_t begin, std::uint64_t end, std::uint64_t seed,
+                                         PiKernel kernel = best_pi_kernel()) {
+    if (!pi_kernel_supported(kernel))
+        throw std::invalid_argument(std::string("Unsupported kernel: ") + to_string(kernel));
+    if (begin >= end)
+        return 0;
+
+    switch (kernel) {
+#ifdef PI_SIMD_X86
+        case PiKernel::sse2:
+            return monte_carlo_outside_sse2(begin, end, seed);
+        case PiKernel::avx2:
+            return monte_carlo_outside_avx2(begin, end, seed);
+        case PiKernel::avx512:
+            return monte_carlo_outside_avx512(begin, end, seed);
+#endif
+        default:
+            return monte_carlo_outside_scalar(begin, end, seed);
+    }
+}
+
+/**
+ * @brief The number of blocks, two samples each, in one partition of the parallel estimate.
+ */
+inline constexpr std::uint64_t monte_carlo_partition_blocks = std::uint64_t(1) << 22;
+
+/**
+ * @brief The outcome of a Monte Carlo run.
+ */
+struct MonteCarloResult {
+    std::uint64_t samples = 0;
+    std::uint64_t inside = 0;
+
+    /**
+     * @brief Returns the estimate of pi, 4 inside / samples.
+     */
+    double estimate() const {
+        return samples == 0 ? 0.0 : 4.0 * static_cast<double>(inside) / static_cast<double>(samples);
+    }
+};
+
+/**
+ * @brief Estimates pi from random points on several threads.
+ * @details Sample 2i and 2i + 1 come from Philox block i, whichever thread or lane computes it, so the result
+ * depends only on the number of samples and the seed.
+ *
+ * @param samples The number of points.
+ * @param seed The seed; different seeds give independent runs.
+ * @param threads The number of threads; 0 means one per hardware thread. It does not change the result.
+ * @param kernel The kernel; it must be supported by the running CPU.
+ * @return MonteCarloResult The number of samples and of those inside the quarter disk.
+ * @throws std::invalid_argument If the kernel is not supported.
+ */
+inline MonteCarloResult monte_carlo_pi(std::uint64_t samples, std::uint64_t seed = 0, unsigned threads = 0,
+                                       PiKernel kernel = best_pi_kernel()) {
+    if (!pi_kernel_supported(kernel))
+        throw std::invalid_argument(std::string("Unsupported kernel: ") + to_string(kernel));
+
+    const std::uint64_t blocks = samples / 2;
+    const std::uint64_t partitions = (blocks + monte_carlo_partition_blocks - 1) / monte_carlo_partition_blocks;
+    std::atomic<std::uint64_t> next{0}, outside{0};
+    auto worker = [&] {
+        std::uint64_t local = 0;
+        for (std::uint64_t p; (p = next.fetch_add(1, std::memory_order_relaxed)) < partitions;) {
+            std::uint64_t begin = p * monte_carlo_partition_blocks;
+            local += monte_carlo_outside(begin, std::min(blocks, begin + monte_carlo_partition_blocks), seed, kernel);
+        }
+        outside.fetch_add(local, std::memory_order_relaxed);
+    };
+
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::clamp<std::uint64_t>(partitions, 1, threads));
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; ++t)
+        workers.emplace_back(worker);
+    worker();
+    for (std::thread& w : workers)
+        w.join();
+
+    std::uint64_t total_outside = outside.load();
+    if (samples % 2 == 1)
+        total_outside += monte_carlo_block_outside(blocks, seed, 1);
+    return {samples, samples - total_outside};
+}
+
+#endif // PI_MONTE_CARLO_H
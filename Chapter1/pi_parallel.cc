@@ -0,0 +1,70 @@
+/**
+ * @file pi_parallel.cc
+ * @brief A program that sums the Leibniz series for pi on a growing number of threads.
+ * @details Usage: pi_parallel [n_terms]. The default is 10^10 terms, beyond the reach of the int term count of
+ * calculate_pi. For 1, 2, 4, ... threads up to the hardware thread count (at least 4) the program prints the
+ * time, the throughput and the result in hexadecimal floating point, so it is easy to see that every thread
+ * count yields the same bits.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numbers>
+#include <string>
+
+#include "benchmark.h"
+#include "pi_parallel.h"
+
+/**
+ * @brief The main function that times the parallel sum for several thread counts.
+ *
+ * @param argc The number of command-line arguments provided.
+ * @param argv An array of strings containing the command-line arguments.
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    std::uint64_t n_terms = argc > 1 ? std::stoull(argv[1]) : 10000000000ULL;
+    unsigned max_threads = std::max(4u, default_pi_threads());
+
+    std::cout << "terms: " << n_terms << ", kernel: " << to_string(best_pi_kernel()) << std::endl;
+    std::cout << std::setw(8) << "threads" << std::setw(12) << "seconds" << std::setw(12) << "Gterms/s"
+              << std::setw(26) << "value" << std::setw(12) << "error" << std::endl;
+
+    double reference = 0;
+    bool deterministic = true;
+    for (unsigned threads = 1;; threads = std::min(2 * threads, max_threads)) {
+        Stopwatch watch;
+        double value = calculate_pi_parallel(n_terms, threads);
+        double seconds = watch.seconds();
+        if (threads == 1)
+            reference = value;
+        deterministic = deterministic && value == reference;
+
+        std::cout << std::setw(8) << threads << std::setw(12) << std::setprecision(4) << seconds << std::setw(12)
+                  << n_terms / seconds / 1e9 << std::setw(26) << std::hexfloat << value << std::defaultfloat
+                  << std::setw(12) << std::scientific << std::setprecision(3) << std::abs(value - std::numbers::pi)
+                  << std::defaultfloat << std::endl;
+        if (threads == max_threads)
+            break;
+    }
+
+    std::cout << (deterministic ? "all thread counts agree" : "thread counts disagree") << std::endl;
+    return deterministic ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file pi_parallel.h
+ * @brief Multi-threaded, deterministic summation of the Leibniz series for pi.
+ * @details The index range is cut into partitions of a fixed number of terms, independent of the number of
+ * threads. Threads claim partitions from a shared counter and sum each one with a kernel from pi_simd.h; the
+ * partial sums are then added in partition order with compensation. The same term count therefore gives the
+ * same bits on one thread or on many. Term counts are 64-bit, so runs are not limited to INT_MAX terms.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PI_PARALLEL_H
+#define PI_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "pi_simd.h"
+
+/**
+ * @brief The number of terms in one partition. It is even, so partitions never split a pair of terms.
+ */
+inline constexpr std::uint64_t pi_partition_terms = std::uint64_t(1) << 24;
+
+/**
+ * @brief Returns the number of hardware threads, or 1 if it is unknown.
+ *
+ * @return unsigned The number of threads.
+ */
+inline unsigned default_pi_threads() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/**
+ * @brief Sums the Leibniz terms with indices in [0, n_terms) on several threads.
+ *
+ * @param n_terms The number of terms.
+ * @param threads The number of threads; 0 means one per hardware thread. It does not change the result.
+ * @param kernel The kernel; it must be supported by the running CPU.
+ * @return double The calculated value of pi.
+ * @throws std::invalid_argument If the kernel is not supported.
+ */
+inline double calculate_pi_parallel(std::uint64_t n_terms, unsigned threads = 0, PiKernel kernel = best_pi_kernel()) {
+    if (!pi_kernel_supported(kernel))
+        throw std::invalid_argument(std::string("Unsupported kernel: ") + to_string(kernel));
+
+    std::uint64_t partitions = (n_terms + pi_partition_terms - 1) / pi_partition_terms;
+    std::vector<double> partial(partitions);
+    std::atomic<std::uint64_t> next{0};
+    auto worker = [&] {
+        for (std::uint64_t p; (p = next.fetch_add(1, std::memory_order_relaxed)) < partitions;) {
+            std::uint64_t begin = p * pi_partition_terms;
+            partial[p] = leibniz_range(begin, std::min(n_terms, begin + pi_partition_terms), kernel);
+        }
+    };
+
+    if (threads == 0)
+        threads = default_pi_threads();
+    threads = static_cast<unsigned>(std::min<std::uint64_t>(threads, partitions));
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; ++t)
+        workers.emplace_back(worker);
+    worker();
+    for (std::thread& w : workers)
+        w.join();
+
+    CompensatedSum total;
+    for (double value : partial)
+        total.add(value);
+    return total.value();
+}
+
+#endif // PI_PARALLEL_H
@@ -0,0 +1,149 @@
+/**
+ * @file pi_precision.cc
+ * @brief A program that compares the speed and accuracy of the Leibniz sum in several floating-point types.
+ * @details Usage: pi_precision [target_error] [terms...]. For 10^6, 10^7 and 10^8 terms by default, the program
+ * runs the original loop of calculating_pi.h and the paired, compensated leibniz_pi in float, double, long
+ * double, double-double and __float128. It prints the rounding error, i.e. the distance to the exact partial
+ * sum, next to the total error against pi, which the truncation of the series dominates, and names the fastest
+ * run whose rounding error meets the target (10^-12 by default). The errors are measured against __float128
+ * references, so on compilers without it the program only reports that.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "calculating_pi.h"
+#include "double_double.h"
+#include "pi_precision.h"
+
+/**
+ * @brief One timed run.
+ */
+struct Run {
+    std::string name;
+    double seconds;
+    double rounding_error;
+};
+
+#ifdef __SIZEOF_FLOAT128__
+
+/**
+ * @brief Converts a result to quad precision.
+ */
+template <typename T>
+__float128 to_quad(T value) {
+    return static_cast<__float128>(value);
+}
+
+template <>
+__float128 to_quad(DoubleDouble value) {
+    return __float128(value.hi()) + __float128(value.lo());
+}
+
+/**
+ * @brief Returns |a - b| as a double.
+ */
+double distance(__float128 a, __float128 b) {
+    return static_cast<double>(a > b ? a - b : b - a);
+}
+
+/**
+ * @brief Times both methods in one type and prints their rows.
+ *
+ * @param type The name of the type.
+ * @param n_terms The number of terms.
+ * @param runs The list the runs are appended to.
+ */
+template <typename T>
+void run(const std::string& type, std::uint64_t n_terms, std::vector<Run>& runs) {
+    const __float128 exact = leibniz_partial_sum_reference(n_terms);
+    auto report = [&](const std::string& method, double seconds, T value) {
+        Run result{type + " " + method, seconds, distance(to_quad(value), exact)};
+        std::cout << std::setw(14) << type << std::setw(8) << method << std::setw(12) << n_terms << std::fixed
+                  << std::setprecision(3) << std::setw(10) << seconds << std::setprecision(1) << std::setw(12)
+                  << n_terms / seconds / 1e6 << std::defaultfloat << std::scientific << std::setprecision(2)
+                  << std::setw(12) << result.rounding_error << std::setw(12) << distance(to_quad(value), pi_quad())
+                  << std::defaultfloat << std::endl;
+        runs.push_back(result);
+    };
+
+    Stopwatch watch;
+    T value = calculate_pi<T>(n_terms);
+    report("loop", watch.seconds(), value);
+
+    watch.reset();
+    value = leibniz_pi<T>(n_terms);
+    report("paired", watch.seconds(), value);
+}
+
+/**
+ * @brief The main function that runs every type for several term counts.
+ *
+ * @param argc The number of command-line arguments provided.
+ * @param argv An array of strings containing the command-line arguments.
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    double target = argc > 1 ? std::stod(argv[1]) : 1e-12;
+    std::vector<std::uint64_t> term_counts = {1000000, 10000000, 100000000};
+    if (argc > 2) {
+        term_counts.clear();
+        for (int i = 2; i < argc; ++i)
+            term_counts.push_back(std::stoull(argv[i]));
+    }
+
+    std::cout << "best kernel: " << to_string(best_pi_kernel()) << ", target rounding error: " << target
+              << std::endl;
+    std::cout << std::setw(14) << "type" << std::setw(8) << "method" << std::setw(12) << "terms" << std::setw(10)
+              << "seconds" << std::setw(12) << "Mterms/s" << std::setw(12) << "rounding" << std::setw(12)
+              << "total" << std::endl;
+    for (std::uint64_t n_terms : term_counts) {
+        std::vector<Run> runs;
+        run<float>("float", n_terms, runs);
+        run<double>("double", n_terms, runs);
+        run<long double>("long double", n_terms, runs);
+        run<DoubleDouble>("double-double", n_terms, runs);
+        run<__float128>("__float128", n_terms, runs);
+
+        const Run* cheapest = nullptr;
+        for (const Run& r : runs) {
+            if (r.rounding_error <= target && (cheapest == nullptr || r.seconds < cheapest->seconds))
+                cheapest = &r;
+        }
+        std::cout << "cheapest within target: " << (cheapest ? cheapest->name : "none") << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+#else // __SIZEOF_FLOAT128__
+
+/**
+ * @brief The main function on compilers without __float128, which the error measurements need.
+ *
+ * @return int The exit status of the program.
+ */
+int main() {
+    std::cerr << "pi_precision needs __float128 for its quad-precision reference" << std::endl;
+    return EXIT_FAILURE;
+}
+
+#endif // __SIZEOF_FLOAT128__
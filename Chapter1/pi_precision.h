@@ -0,0 +1,250 @@
+/**
+ * @file pi_precision.h
+ * @brief The Leibniz sum in a choice of floating-point types, from float to quad precision.
+ * @details leibniz_pi<T> sums the series in pairs with Kahan compensation entirely in T, so the result differs
+ * from the exact partial sum only by the rounding of T. Types with vector kernels pick them at compile time:
+ * double uses the kernels of pi_simd.h, float has AVX2 and AVX-512 kernels of its own, and long double,
+ * DoubleDouble and __float128, which have no vector instructions, use the generic loop.
+ *
+ * leibniz_partial_sum_reference gives the exact partial sum to quad precision from the expansion
+ * pi - S_n = (-1)^n 2 sum_j E_2j / (2n)^(2j + 1) in the Euler numbers E_0, E_2, ... = 1, -1, 5, -61, ..., so
+ * the rounding error of a type can be measured apart from the truncation error of the series.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PI_PRECISION_H
+#define PI_PRECISION_H
+
+#include <cstdint>
+#include <type_traits>
+
+#include "double_double.h"
+#include "pi_simd.h"
+
+/**
+ * @brief A running sum with Kahan compensation in any floating-point type.
+ * @details Unlike CompensatedSum it assumes that the sum outgrows every addend, which holds for the positive
+ * Leibniz pairs.
+ */
+template <typename T>
+struct KahanSum {
+    T sum = 0;
+    T compensation = 0;
+
+    void add(T value) {
+        T y = value - compensation;
+        T t = sum + y;
+        compensation = (t - sum) - y;
+        sum = t;
+    }
+
+    T value() const {
+        return sum;
+    }
+};
+
+/**
+ * @brief Sums the Leibniz term pairs with indices in [begin, end) in type T, one pair at a time.
+ * @details 4k + 1 is formed in double, which is exact for k < 2^51.
+ *
+ * @param begin The index of the first pair.
+ * @param end One past the index of the last pair.
+ * @return T The sum of the pairs.
+ */
+template <typename T>
+T leibniz_pairs(std::uint64_t begin, std::uint64_t end) {
+    const T eight = 8.0, two = 2.0;
+    KahanSum<T> total;
+    for (std::uint64_t k = begin; k < end; ++k) {
+        T a = 4.0 * double(k) + 1.0;
+        total.add(eight / (a * (a + two)));
+    }
+    return total.value();
+}
+
+#ifdef PI_SIMD_X86
+
+/**
+ * @brief Sums the Leibniz term pairs in [begin, end) in float, sixteen at a time with AVX2.
+ * @details 4k + 1 advances in float by a power of two, so it drifts by at most an ulp once it is no longer
+ * exact, a relative error of the order of the rounding of float itself.
+ */
+__attribute__((target("avx2"))) inline float leibniz_pairs_float_avx2(std::uint64_t begin, std::uint64_t end) {
+    constexpr int lanes = 8;
+    const __m256 eight = _mm256_set1_ps(8.0f);
+    const __m256 two = _mm256_set1_ps(2.0f);
+    const __m256 step = _mm256_set1_ps(8.0f * lanes);
+    const float a = static_cast<float>(4.0 * double(begin) + 1.0);
+    __m256 a0 = _mm256_add_ps(_mm256_set1_ps(a), _mm256_setr_ps(0, 4, 8, 12, 16, 20, 24, 28));
+    __m256 a1 = _mm256_add_ps(a0, _mm256_set1_ps(4.0f * lanes));
+    __m256 s0 = _mm256_setzero_ps(), c0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps(), c1 = _mm256_setzero_ps();
+
+    std::uint64_t k = begin;
+    for (; k + 2 * lanes <= end; k += 2 * lanes) {
+        __m256 y0 = _mm256_sub_ps(_mm256_div_ps(eight, _mm256_mul_ps(a0, _mm256_add_ps(a0, two))), c0);
+        __m256 y1 = _mm256_sub_ps(_mm256_div_ps(eight, _mm256_mul_ps(a1, _mm256_add_ps(a1, two))), c1);
+        __m256 t0 = _mm256_add_ps(s0, y0);
+        __m256 t1 = _mm256_add_ps(s1, y1);
+        c0 = _mm256_sub_ps(_mm256_sub_ps(t0, s0), y0);
+        c1 = _mm256_sub_ps(_mm256_sub_ps(t1, s1), y1);
+        s0 = t0;
+        s1 = t1;
+        a0 = _mm256_add_ps(a0, step);
+        a1 = _mm256_add_ps(a1, step);
+    }
+
+    alignas(32) float sums[2 * lanes], compensations[2 * lanes];
+    _mm256_store_ps(sums, s0);
+    _mm256_store_ps(sums + lanes, s1);
+    _mm256_store_ps(compensations, c0);
+    _mm256_store_ps(compensations + lanes, c1);
+    KahanSum<float> total;
+    for (int lane = 0; lane < 2 * lanes; ++lane) {
+        total.add(sums[lane]);
+        total.add(-compensations[lane]);
+    }
+    total.add(leibniz_pairs<float>(k, end));
+    return total.value();
+}
+
+/**
+ * @brief Sums the Leibniz term pairs in [begin, end) in float, thirty-two at a time with AVX-512.
+ * @details The divider is replaced by a 14-bit reciprocal estimate and one Newton step, which is exact to
+ * about 28 bits, more than float keeps.
+ */
+__attribute__((target("avx512f"))) inline float leibniz_pairs_float_avx512(std::uint64_t begin, std::uint64_t end) {
+    constexpr int lanes = 16;
+    const __m512 eight = _mm512_set1_ps(8.0f);
+    const __m512 one = _mm512_set1_ps(1.0f);
+    const __m512 two = _mm512_set1_ps(2.0f);
+    const __m512 step = _mm512_set1_ps(8.0f * lanes);
+    const float a = static_cast<float>(4.0 * double(begin) + 1.0);
+    __m512 a0 = _mm512_add_ps(_mm512_set1_ps(a), _mm512_setr_ps(0, 4, 8, 12, 16, 20, 24, 28, 32, 36, 40, 44, 48,
+                                                                 52, 56, 60));
+    __m512 a1 = _mm512_add_ps(a0, _mm512_set1_ps(4.0f * lanes));
+    __m512 s0 = _mm512_setzero_ps(), c0 = _mm512_setzero_ps(), s1 = _mm512_setzero_ps(), c1 = _mm512_setzero_ps();
+
+    std::uint64_t k = begin;
+    for (; k + 2 * lanes <= end; k += 2 * lanes) {
+        __m512 d0 = _mm512_mul_ps(a0, _mm512_add_ps(a0, two));
+        __m512 d1 = _mm512_mul_ps(a1, _mm512_add_ps(a1, two));
+        __m512 r0 = _mm512_rcp14_ps(d0);
+        __m512 r1 = _mm512_rcp14_ps(d1);
+        r0 = _mm512_fmadd_ps(r0, _mm512_fnmadd_ps(d0, r0, one), r0);
+        r1 = _mm512_fmadd_ps(r1, _mm512_fnmadd_ps(d1, r1, one), r1);
+        __m512 y0 = _mm512_sub_ps(_mm512_mul_ps(eight, r0), c0);
+        __m512 y1 = _mm512_sub_ps(_mm512_mul_ps(eight, r1), c1);
+        __m512 t0 = _mm512_add_ps(s0, y0);
+        __m512 t1 = _mm512_add_ps(s1, y1);
+        c0 = _mm512_sub_ps(_mm512_sub_ps(t0, s0), y0);
+        c1 = _mm512_sub_ps(_mm512_sub_ps(t1, s1), y1);
+        s0 = t0;
+        s1 = t1;
+        a0 = _mm512_add_ps(a0, step);
+        a1 = _mm512_add_ps(a1, step);
+    }
+
+    alignas(64) float sums[2 * lanes], compensations[2 * lanes];
+    _mm512_store_ps(sums, s0);
+    _mm512_store_ps(sums + lanes, s1);
+    _mm512_store_ps(compensations, c0);
+    _mm512_store_ps(compensations + lanes, c1);
+    KahanSum<float> total;
+    for (int lane = 0; lane < 2 * lanes; ++lane) {
+        total.add(sums[lane]);
+        total.add(-compensations[lane]);
+    }
+    total.add(leibniz_pairs<float>(k, end));
+    return total.value();
+}
+
+#endif // PI_SIMD_X86
+
+/**
+ * @brief Calculates pi with the first n_terms terms of the Leibniz series in type T.
+ *
+ * @tparam T float, double, long double, DoubleDouble, __float128 or any type with the same operations.
+ * @param n_terms The number of terms.
+ * @return T The partial sum.
+ */
+template <typename T>
+T leibniz_pi(std::uint64_t n_terms) {
+    if constexpr (std::is_same_v<T, double>) {
+        return calculate_pi_simd(n_terms);
+    } else {
+        std::uint64_t pairs = n_terms / 2;
+        T sum;
+        if constexpr (std::is_same_v<T, float>) {
+            switch (best_pi_kernel()) {
+#ifdef PI_SIMD_X86
+                case PiKernel::avx512:
+                    sum = leibniz_pairs_float_avx512(0, pairs);
+                    break;
+                case PiKernel::avx2:
+                    sum = leibniz_pairs_float_avx2(0, pairs);
+                    break;
+#endif
+                default:
+                    sum = leibniz_pairs<float>(0, pairs);
+                    break;
+            }
+        } else {
+            sum = leibniz_pairs<T>(0, pairs);
+        }
+        if (n_terms % 2 == 1)  // the last term has an even index and is positive
+            sum += T(4.0) / T(2.0 * double(n_terms) - 1.0);
+        return sum;
+    }
+}
+
+#ifdef __SIZEOF_FLOAT128__
+
+/**
+ * @brief Returns pi in quad precision, as the sum of three doubles.
+ */
+inline __float128 pi_quad() {
+    return __float128(0x1.921fb54442d18p+1) + __float128(0x1.1a62633145c07p-53) +
+           __float128(-0x1.f1976b7ed8fbcp-109);
+}
+
+/**
+ * @brief Returns the exact sum of the first n_terms Leibniz terms to quad precision.
+ * @details The expansion is truncated after E_10, which leaves an error below 10^-36 for n_terms >= 1000;
+ * fewer terms are summed directly.
+ *
+ * @param n_terms The number of terms.
+ * @return __float128 The partial sum.
+ */
+inline __float128 leibniz_partial_sum_reference(std::uint64_t n_terms) {
+    if (n_terms < 1000) {
+        __float128 sum = 0;
+        for (std::uint64_t i = n_terms; i-- > 0;)  // smallest terms first
+            sum += (i % 2 == 0 ? 4 : -4) / __float128(2 * i + 1);
+        return sum;
+    }
+    constexpr double euler_numbers[] = {1, -1, 5, -61, 1385, -50521};
+    const __float128 x = __float128(1) / (2 * __float128(n_terms));
+    __float128 power = x, remainder = 0;
+    for (double e : euler_numbers) {
+        remainder += e * power;
+        power *= x * x;
+    }
+    remainder *= 2;
+    return n_terms % 2 == 0 ? pi_quad() - remainder : pi_quad() + remainder;
+}
+
+#endif // __SIZEOF_FLOAT128__
+
+#endif // PI_PRECISION_H
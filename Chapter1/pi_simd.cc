@@ -0,0 +1,75 @@
+/**
+ * @file pi_simd.cc
+ * @brief A program that compares the vectorized Leibniz kernels with the original calculate_pi.
+ * @details For growing term counts this program runs calculate_pi (float, sequential) and every Leibniz kernel the CPU supports, and prints the throughput in terms per second together with the absolute error against pi. Because the Leibniz series is truncated, the best achievable error is about 1 / n_terms.
+ * @copyright Copyright 2023 Kyungwon Chun
+ * 
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numbers>
+#include <string>
+
+#include "benchmark.h"
+#include "calculating_pi.h"
+#include "pi_simd.h"
+
+/**
+ * @brief Prints one row of results.
+ * 
+ * @param name The name of the method.
+ * @param n_terms The number of terms.
+ * @param seconds The time taken.
+ * @param value The calculated value of pi.
+ */
+void print_row(const std::string& name, std::uint64_t n_terms, double seconds, double value) {
+    std::cout << std::setw(12) << n_terms << std::setw(10) << name << std::setw(14) << std::setprecision(4)
+              << n_terms / seconds / 1e6 << std::setw(14) << std::scientific << std::setprecision(3)
+              << std::abs(value - std::numbers::pi) << std::defaultfloat << std::endl;
+}
+
+/**
+ * @brief The main function that times every method for several term counts.
+ * 
+ * @param argc The number of command-line arguments provided.
+ * @param argv An array of strings containing the command-line arguments.
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    std::cout << "best kernel: " << to_string(best_pi_kernel()) << std::endl;
+    std::cout << std::setw(12) << "terms" << std::setw(10) << "method" << std::setw(14) << "Mterms/s"
+              << std::setw(14) << "error" << std::endl;
+
+    for (std::uint64_t n_terms : {1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL}) {
+        Stopwatch watch;
+        float original = calculate_pi(n_terms);
+        do_not_optimize(original);
+        print_row("float", n_terms, watch.seconds(), original);
+
+        for (PiKernel kernel : {PiKernel::scalar, PiKernel::sse2, PiKernel::avx2, PiKernel::avx512}) {
+            if (!pi_kernel_supported(kernel))
+                continue;
+            watch.reset();
+            double value = calculate_pi_simd(n_terms, kernel);
+            do_not_optimize(value);
+            print_row(to_string(kernel), n_terms, watch.seconds(), value);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file pi_spigot.cc
+ * @brief A program that streams the digits of pi from the spigot and reports its speed and memory.
+ * @details Usage: pi_spigot [digits...]. By default the program reads 10^4 and 10^5 digits; the spigot takes
+ * quadratic time, so 10^6 digits (pi_spigot 1000000) run about a hundred times longer than 10^5. For every count
+ * it prints the digits per second, the memory held by the spigot and the resident set of the process while the
+ * spigot is alive, and the last ten digits.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "pi_spigot.h"
+
+/**
+ * @brief The main function that times the spigot for several digit counts.
+ *
+ * @param argc The number of command-line arguments provided.
+ * @param argv An array of strings containing the command-line arguments.
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    std::vector<std::size_t> digit_counts = {10000, 100000};
+    if (argc > 1) {
+        digit_counts.clear();
+        for (int i = 1; i < argc; ++i)
+            digit_counts.push_back(std::stoull(argv[i]));
+    }
+
+    std::cout << std::setw(10) << "digits" << std::setw(12) << "seconds" << std::setw(14) << "digits/s"
+              << std::setw(14) << "spigot MiB" << std::setw(12) << "RSS MiB" << std::setw(14) << "last digits"
+              << std::endl;
+    for (std::size_t digits : digit_counts) {
+        Stopwatch watch;
+        PiDigitView view = pi_digits(digits);
+        std::string tail;
+        for (char digit : view) {
+            tail.push_back(digit);
+            if (tail.size() > 10)
+                tail.erase(tail.begin());
+        }
+        double seconds = watch.seconds();
+
+        std::cout << std::setw(10) << digits << std::fixed << std::setprecision(3) << std::setw(12) << seconds
+                  << std::setprecision(0) << std::setw(14) << digits / seconds << std::setprecision(2)
+                  << std::setw(14) << view.spigot().memory_bytes() / 1048576.0 << std::setw(12)
+                  << process_memory_bytes("VmRSS") / 1048576.0 << std::defaultfloat << std::setw(14) << tail
+                  << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
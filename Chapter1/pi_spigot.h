@@ -0,0 +1,318 @@
+/**
+ * @file pi_spigot.h
+ * @brief A spigot that streams the decimal digits of pi in bounded memory.
+ * @details PiSpigot implements the Rabinowitz-Wagon spigot in the form of the well-known "pi in 160 characters"
+ * C program: pi is held as a mixed-radix number with bases 1/3, 2/5, 3/7, ..., and every pass multiplies it by
+ * 10^8, normalizes it from the least significant place up and emits the next eight digits. A pass needs about
+ * 3.5 places per remaining digit, so the number of places shrinks by 28 per pass and the memory is one 32-bit
+ * remainder per place, fixed when the spigot is constructed and never grown.
+ *
+ * Every place costs one 64-bit division whose quotient feeds the next place, so a single pass is a chain of
+ * dependent divisions. Pass k + 1 only reads place b after pass k has written it; running four consecutive
+ * passes in lockstep, each one place behind the previous, keeps four independent chains in flight.
+ *
+ * A chunk can overflow into the chunk before it, so chunks are held back while they might still receive a
+ * carry, just like the predigits of the original algorithm.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PI_SPIGOT_H
+#define PI_SPIGOT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <vector>
+
+/**
+ * @brief Produces the decimal digits 3, 1, 4, 1, 5, ... of pi one at a time.
+ */
+class PiSpigot {
+public:
+    /**
+     * @brief The digits emitted per pass and their base.
+     */
+    static constexpr int chunk_digits = 8;
+    static constexpr std::uint64_t chunk_base = 100000000;
+
+    /**
+     * @brief The places dropped after every pass, 3.5 per digit.
+     */
+    static constexpr std::size_t places_per_chunk = 28;
+
+    /**
+     * @brief The number of passes that run in lockstep.
+     */
+    static constexpr std::size_t interleaved_passes = 4;
+
+    /**
+     * @brief Extra chunks computed past the requested digits, whose last places are not yet exact.
+     */
+    static constexpr std::size_t guard_chunks = 2;
+
+    /**
+     * @brief Prepares a spigot for a number of digits, counting the leading 3.
+     *
+     * @param digits The number of digits that will be produced.
+     */
+    explicit PiSpigot(std::size_t digits) : _remaining_digits(digits) {
+        std::size_t chunks = (digits + chunk_digits - 1) / chunk_digits + guard_chunks;
+        _places = places_per_chunk * chunks;
+        _remainders.assign(_places + 1, static_cast<std::uint32_t>(2 * chunk_base / 10));
+        _remainders[_places] = 0;
+    }
+
+    /**
+     * @brief Returns whether all requested digits have been produced.
+     *
+     * @return bool True if next() must not be called again.
+     */
+    bool done() const {
+        return _remaining_digits == 0;
+    }
+
+    /**
+     * @brief Returns the next digit as a character.
+     *
+     * @return char The digit, '0' through '9'.
+     */
+    char next() {
+        if (_read == _ready.size())
+            _refill();
+        --_remaining_digits;
+        return _ready[_read++];
+    }
+
+    /**
+     * @brief Returns the bytes held by the spigot.
+     *
+     * @return std::size_t The size of the remainders and the digit buffer.
+     */
+    std::size_t memory_bytes() const {
+        return _remainders.capacity() * sizeof(std::uint32_t) + _ready.capacity();
+    }
+
+private:
+    /**
+     * @brief Runs passes until at least one digit is ready.
+     */
+    void _refill() {
+        _ready.clear();
+        _read = 0;
+        while (_ready.empty() && (_places != 0 || _has_held)) {
+            if (_places == 0)
+                _flush_held();
+            else
+                _run_passes(std::min(interleaved_passes, _places / places_per_chunk));
+        }
+    }
+
+    /**
+     * @brief Runs count consecutive passes in lockstep and hands their chunks to _accept.
+     * @details At step t, pass i works on place places - t + i, i.e. one place above pass i - 1, which wrote
+     * that place in the previous step.
+     */
+    void _run_passes(std::size_t count) {
+        std::uint64_t d[interleaved_passes] = {};
+        std::uint32_t* f = _remainders.data();
+        const std::size_t top = _places;
+
+        auto step = [f](std::uint64_t& value, std::size_t b) {
+            std::uint64_t g = 2 * b - 1;
+            value += f[b] * chunk_base;
+            f[b] = static_cast<std::uint32_t>(value % g);
+            value = value / g * (b - 1);
+        };
+        auto step_last = [f](std::uint64_t& value) {  // place 1 divides by 1 and passes its value on unscaled
+            value += f[1] * chunk_base;
+            f[1] = 0;
+        };
+
+        // Pass i starts 29 * i steps late and its top place is 28 * i lower, so it runs one place above pass i - 1.
+        const std::size_t lag = places_per_chunk + 1;
+        for (std::size_t t = 0; t + 1 < top + count; ++t) {
+            for (std::size_t i = 0; i < count; ++i) {
+                if (t < lag * i || t >= top + i)
+                    continue;
+                std::size_t b = top + i - t;
+                if (b == 1)
+                    step_last(d[i]);
+                else
+                    step(d[i], b);
+            }
+        }
+
+        for (std::size_t i = 0; i < count; ++i) {
+            std::uint64_t chunk = _carry + d[i] / chunk_base;
+            _carry = d[i] % chunk_base;
+            _accept(chunk);
+        }
+        _places -= places_per_chunk * count;
+    }
+
+    /**
+     * @brief Takes the next chunk, which may exceed the base by a carry into the held chunks.
+     */
+    void _accept(std::uint64_t chunk) {
+        if (chunk >= chunk_base) {
+            ++_held;  // the held chunk is below 99999999, so it absorbs the carry and the nines after it wrap to 0
+            _nines_to_zeros = true;
+            chunk -= chunk_base;
+            _flush_held();
+        }
+        if (chunk == chunk_base - 1 && _has_held) {
+            ++_held_nines;
+            return;
+        }
+        _flush_held();
+        _held = static_cast<std::uint32_t>(chunk);
+        _has_held = true;
+    }
+
+    /**
+     * @brief Appends the held chunk and its run of nines to the ready digits.
+     */
+    void _flush_held() {
+        if (_has_held) {
+            _append(_held, chunk_digits);
+            for (; _held_nines > 0; --_held_nines)
+                _append(_nines_to_zeros ? 0 : static_cast<std::uint32_t>(chunk_base - 1), chunk_digits);
+        }
+        _nines_to_zeros = false;
+        _has_held = false;
+    }
+
+    /**
+     * @brief Appends the lowest digits of a chunk, most significant first, up to the requested count.
+     */
+    void _append(std::uint32_t chunk, int digits) {
+        char text[chunk_digits];
+        for (int i = digits - 1; i >= 0; --i, chunk /= 10)
+            text[i] = static_cast<char>('0' + chunk % 10);
+        std::size_t wanted = _remaining_digits > _ready.size() ? _remaining_digits - _ready.size() : 0;
+        _ready.insert(_ready.end(), text, text + std::min<std::size_t>(digits, wanted));
+    }
+
+    std::vector<std::uint32_t> _remainders;
+    std::size_t _places;
+    std::size_t _remaining_digits;
+    std::uint64_t _carry = 0;
+    std::uint32_t _held = 0;
+    std::size_t _held_nines = 0;
+    bool _has_held = false;
+    bool _nines_to_zeros = false;
+    std::vector<char> _ready;
+    std::size_t _read = 0;
+};
+
+/**
+ * @brief A lazy input range over the first digits of pi, as the characters '3', '1', '4', ...
+ * @details The view owns its spigot, so it can be moved but not copied; iterating it a second time continues
+ * where the first iteration stopped, as with any input range.
+ */
+class PiDigitView : public std::ranges::view_interface<PiDigitView> {
+public:
+    /**
+     * @brief An input iterator that runs the spigot when it runs out of digits.
+     */
+    class iterator {
+    public:
+        using value_type = char;
+        using difference_type = std::ptrdiff_t;
+        using iterator_concept = std::input_iterator_tag;
+
+        iterator() = default;
+
+        explicit iterator(PiSpigot* spigot) : _spigot(spigot) {
+            ++*this;
+        }
+
+        char operator*() const {
+            return _digit;
+        }
+
+        iterator& operator++() {
+            if (_spigot->done())
+                _spigot = nullptr;
+            else
+                _digit = _spigot->next();
+            return *this;
+        }
+
+        void operator++(int) {
+            ++*this;
+        }
+
+        friend bool operator==(const iterator& it, std::default_sentinel_t) {
+            return it._spigot == nullptr;
+        }
+
+    private:
+        PiSpigot* _spigot = nullptr;
+        char _digit = 0;
+    };
+
+    /**
+     * @brief Constructs a view of the first digits of pi.
+     *
+     * @param digits The number of digits, counting the leading 3.
+     */
+    explicit PiDigitView(std::size_t digits) : _spigot(std::make_unique<PiSpigot>(digits)) {}
+
+    /**
+     * @brief Returns an iterator to the next digit that has not been read.
+     *
+     * @return iterator The first position of the view.
+     */
+    iterator begin() {
+        return iterator(_spigot.get());
+    }
+
+    /**
+     * @brief Returns the sentinel that ends the view after the last digit.
+     *
+     * @return std::default_sentinel_t The sentinel.
+     */
+    std::default_sentinel_t end() const {
+        return std::default_sentinel;
+    }
+
+    /**
+     * @brief Returns the spigot behind the view, e.g. to query its memory.
+     *
+     * @return const PiSpigot& The spigot.
+     */
+    const PiSpigot& spigot() const {
+        return *_spigot;
+    }
+
+private:
+    std::unique_ptr<PiSpigot> _spigot;
+};
+
+/**
+ * @brief Lazily generates the first digits of pi.
+ *
+ * @param digits The number of digits, counting the leading 3.
+ * @return PiDigitView A view of the digits.
+ */
+inline PiDigitView pi_digits(std::size_t digits) {
+    return PiDigitView(digits);
+}
+
+#endif // PI_SPIGOT_H
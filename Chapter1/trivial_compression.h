@@ -0,0 +1,376 @@
+/**
+ * @file trivial_compression.h
+ * @brief Gene compression with one integer of type T per chunk of nucleotides.
+ * @details CompressedGene stores a nucleotide sequence as 2-bit codes behind a sentinel 1 bit in a single integer,
+ * and CompressedGene2 splits a longer sequence into chunks that fit one CompressedGene<T> each. Both decode into
+ * caller buffers or through forward iterators, so printing and comparing never build a copy of the whole gene.
+ * @copyright Copyright 2023 Kyungwon Chun
+ * 
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRIVIAL_COMPRESSION_H
+#define TRIVIAL_COMPRESSION_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief A class that compresses and decompresses gene sequences.
+ * 
+ * @tparam T The type of the compressed gene.
+ */
+template<typename T>
+class CompressedGene {
+public:
+    /**
+     * @brief Constructor for CompressedGene class that takes a gene string and compresses it.
+     * 
+     * @tparam T The type of the compressed gene.
+     * @param gene The gene string to be compressed.
+     */
+    CompressedGene(const std::string& gene): _bit_string(1) {
+        _compress(gene);
+    }
+
+    /**
+     * @brief A forward iterator over the bases that decodes them on the fly.
+     */
+    class const_iterator {
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = char;
+        using difference_type = std::ptrdiff_t;
+
+        const_iterator() = default;
+
+        const_iterator(T bit_string, int shift): _bit_string(bit_string), _shift(shift) {}
+
+        char operator*() const {
+            return "ACGT"[(_bit_string >> _shift) & 0b11];
+        }
+
+        const_iterator& operator++() {
+            _shift -= 2;
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const const_iterator& other) const = default;
+
+    private:
+        T _bit_string = 0;
+        int _shift = -2;  // the position of the current base; -2 past the last one
+    };
+
+    /**
+     * @brief Returns an iterator to the first base.
+     */
+    const_iterator begin() const {
+        return const_iterator(_bit_string, bit_length() - 3);  // - 3 to exclude sentinel
+    }
+
+    /**
+     * @brief Returns an iterator past the last base.
+     */
+    const_iterator end() const {
+        return const_iterator(_bit_string, -2);
+    }
+
+    /**
+     * @brief Returns the number of bases.
+     */
+    std::size_t size() const {
+        return (bit_length() - 1) / 2;
+    }
+
+    /**
+     * @brief Decompresses the bases into a caller buffer without allocating.
+     * 
+     * @tparam T The type of the compressed gene.
+     * @param out The buffer; if it is shorter than the gene, only its first out.size() bases are written.
+     * @return The number of bases written.
+     */
+    std::size_t decompress_into(std::span<char> out) const {
+        std::size_t count = 0;
+        for (const_iterator it = begin(); it != end() && count < out.size(); ++it)
+            out[count++] = *it;
+        return count;
+    }
+
+    /**
+     * @brief Decompresses the compressed gene sequence.
+     * 
+     * @tparam T The type of the compressed gene.
+     * @return The decompressed gene sequence.
+     */
+    std::string decompress() const {
+        std::string gene(size(), '\0');
+        decompress_into(gene);
+        return gene;
+    }
+
+    /**
+     * @brief Returns the compressed gene sequence.
+     * 
+     * @tparam T The type of the compressed gene.
+     * @return The compressed gene sequence.
+     */
+    T bit_string() const {
+        return _bit_string;
+    }
+
+    /**
+     * @brief Returns the length of the compressed gene sequence in bits.
+     * 
+     * @tparam T The type of the compressed gene.
+     * @return The length of the compressed gene sequence in bits.
+     */
+    int bit_length() const {
+        return log2(_bit_string) + 1;
+    }
+
+private:
+    /**
+     * @brief Compresses the gene sequence.
+     * 
+     * @tparam T The type of the compressed gene.
+     * @param gene The gene sequence to be compressed.
+     */
+    void _compress(const std::string& gene) {
+        for (char nucleotide : gene) {
+            _bit_string <<= 2;  // shift left two bits
+            switch (nucleotide) {  
+                case 'A':  // change last two bits to 00
+                    _bit_string |= 0b00;
+                    break;
+                case 'C':  // change last two bits to 01
+                    _bit_string |= 0b01;
+                    break;
+                case 'G':  // change last two bits to 10
+                    _bit_string |= 0b10;
+                    break;
+                case 'T':  // change last two bits to 11
+                    _bit_string |= 0b11;
+                    break;
+                default:
+                    throw std::invalid_argument("Invalid Nucleotide: " + std::string(1, nucleotide));
+            }
+        }
+    }
+
+    T _bit_string;
+};
+
+
+/**
+ * @brief A template function that performs trivial compression on a given data type.
+ * 
+ * @tparam T The data type to be compressed.
+ */
+template<typename T>
+std::ostream& operator<<(std::ostream& out, const CompressedGene<T>& gene) {
+    char buffer[sizeof(T) * 4];
+    out.write(buffer, gene.decompress_into(buffer));
+    return out;
+}
+
+/**
+ * @brief A class that represents a compressed gene using a vector of CompressedGene objects.
+ * 
+ * @tparam T The type of the CompressedGene object.
+ */
+template<typename T>
+class CompressedGene2 {
+public:
+    /**
+     * @brief Constructs a CompressedGene2 object from a given gene string.
+     * 
+     * @param gene The gene string to be compressed.
+     */
+    CompressedGene2(const std::string& gene): _size(gene.size()) {
+        int chunk_size = (sizeof(T) * 8 - 1) / 2;
+        int num_chunks = int(gene.size() / chunk_size + 1);
+        int i = 0;
+        while (i < num_chunks - 1) {
+            container.emplace_back(CompressedGene<T>(gene.substr(i * chunk_size, chunk_size)));
+            i++;
+        }
+        container.emplace_back(gene.substr(i * chunk_size));
+    }
+
+    /**
+     * @brief A forward iterator over the bases of all chunks that decodes them on the fly.
+     */
+    class const_iterator {
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = char;
+        using difference_type = std::ptrdiff_t;
+
+        const_iterator() = default;
+
+        const_iterator(const CompressedGene<T>* chunk, const CompressedGene<T>* last): _chunk(chunk), _last(last) {
+            _skip_empty_chunks();
+        }
+
+        char operator*() const {
+            return *_base;
+        }
+
+        const_iterator& operator++() {
+            if (++_base == _chunk->end()) {
+                ++_chunk;
+                _skip_empty_chunks();
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const const_iterator& other) const = default;
+
+    private:
+        /**
+         * @brief Moves to the first base of the next chunk that has one, or to the end.
+         */
+        void _skip_empty_chunks() {
+            while (_chunk != _last && _chunk->size() == 0)
+                ++_chunk;
+            _base = _chunk != _last ? _chunk->begin() : typename CompressedGene<T>::const_iterator();
+        }
+
+        const CompressedGene<T>* _chunk = nullptr;
+        const CompressedGene<T>* _last = nullptr;
+        typename CompressedGene<T>::const_iterator _base;
+    };
+
+    /**
+     * @brief Returns an iterator to the first base.
+     */
+    const_iterator begin() const {
+        return const_iterator(container.data(), container.data() + container.size());
+    }
+
+    /**
+     * @brief Returns an iterator past the last base.
+     */
+    const_iterator end() const {
+        return const_iterator(container.data() + container.size(), container.data() + container.size());
+    }
+
+    /**
+     * @brief Returns the number of bases.
+     */
+    std::size_t size() const {
+        return _size;
+    }
+
+    /**
+     * @brief Decompresses the bases into a caller buffer without allocating, chunk by chunk.
+     * 
+     * @param out The buffer; if it is shorter than the gene, only its first out.size() bases are written.
+     * @return The number of bases written.
+     */
+    std::size_t decompress_into(std::span<char> out) const {
+        std::size_t count = 0;
+        for (const CompressedGene<T>& chunk : container) {
+            if (count == out.size())
+                break;
+            count += chunk.decompress_into(out.subspan(count));
+        }
+        return count;
+    }
+
+    /**
+     * @brief Decompresses the gene string and returns it.
+     * 
+     * @return The decompressed gene string.
+     */
+    std::string decompress() const {
+        std::string gene(_size, '\0');
+        decompress_into(gene);
+        return gene;
+    }
+
+    /**
+     * @brief Writes the bases to a stream through a fixed buffer, without decompressing the whole gene.
+     * 
+     * @param out The stream.
+     */
+    void print(std::ostream& out) const {
+        constexpr std::size_t buffer_size = 4096;
+        char buffer[buffer_size];
+        std::size_t used = 0;
+        for (const CompressedGene<T>& chunk : container) {
+            if (buffer_size - used < sizeof(T) * 4) {
+                out.write(buffer, used);
+                used = 0;
+            }
+            used += chunk.decompress_into(std::span<char>(buffer + used, buffer_size - used));
+        }
+        out.write(buffer, used);
+    }
+
+    /**
+     * @brief Returns the bit length of the compressed gene.
+     * 
+     * @return The bit length of the compressed gene.
+     */
+    int bit_length() const {
+        return 8 * sizeof(T) * container.size();
+    }
+
+    /**
+     * @brief Compares the bases with a string, decoding them on the fly.
+     */
+    friend bool operator==(const CompressedGene2& gene, std::string_view bases) {
+        return gene.size() == bases.size() && std::equal(bases.begin(), bases.end(), gene.begin());
+    }
+
+private:
+    std::vector<CompressedGene<T>> container;
+    std::size_t _size;
+};
+
+/**
+ * @brief A template function that compresses data of any type T.
+ * 
+ * @tparam T The type of data to be compressed.
+ */
+template<typename T>
+std::ostream& operator<<(std::ostream& out, const CompressedGene2<T>& gene) {
+    gene.print(out);
+    return out;
+}
+
+#endif // TRIVIAL_COMPRESSION_H
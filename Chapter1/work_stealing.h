@@ -0,0 +1,483 @@
+/**
+ * @file work_stealing.h
+ * @brief A small work-stealing scheduler for fork-join parallelism.
+ * @details Every worker thread owns a Chase-Lev deque: it pushes and pops tasks at the bottom without locking,
+ * while idle workers steal from the top of a random victim's deque. TaskGroup provides the spawn/sync
+ * interface: spawn() pushes a task onto the current worker's deque, and sync() keeps executing local or stolen
+ * tasks until every task spawned by the group has finished, so a waiting worker never sits idle while work is
+ * available. Each worker counts the tasks it executed, its successful steals and the time it spent idle.
+ * @copyright Copyright 2023 Kyungwon Chun
+ *
+ * @license Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WORK_STEALING_H
+#define WORK_STEALING_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A lock-free work-stealing deque of pointers after Chase and Lev.
+ * @details Only the owning thread may call push() and take(); any thread may call steal(). The memory orders
+ * follow "Correct and Efficient Work-Stealing for Weak Memory Models" (Le et al., 2013), except that slots are
+ * written with release and read with acquire, which publishes the pointee to a thief without relying on the
+ * fences alone (free on x86, and visible to ThreadSanitizer). Arrays replaced by a resize are kept until the
+ * deque is destroyed, because a concurrent thief may still be reading them.
+ *
+ * @tparam T The pointee type.
+ */
+template <typename T>
+class ChaseLevDeque {
+public:
+    /**
+     * @brief Constructs an empty deque.
+     *
+     * @param capacity The initial capacity, which must be a power of two.
+     */
+    explicit ChaseLevDeque(std::size_t capacity = 256) {
+        _arrays.push_back(std::make_unique<Array>(capacity));
+        _array.store(_arrays.back().get(), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Pushes an item at the bottom; owner only.
+     *
+     * @param item The item to be pushed.
+     */
+    void push(T* item) {
+        std::int64_t b = _bottom.load(std::memory_order_relaxed);
+        std::int64_t t = _top.load(std::memory_order_acquire);
+        Array* array = _array.load(std::memory_order_relaxed);
+        if (b - t > static_cast<std::int64_t>(array->size()) - 1)
+            array = _grow(array, t, b);
+        array->put(b, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        _bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Pops the most recently pushed item; owner only.
+     *
+     * @return T* The item, or nullptr if the deque is empty.
+     */
+    T* take() {
+        std::int64_t b = _bottom.load(std::memory_order_relaxed) - 1;
+        Array* array = _array.load(std::memory_order_relaxed);
+        _bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = _top.load(std::memory_order_relaxed);
+
+        T* item = nullptr;
+        if (t <= b) {
+            item = array->get(b);
+            if (t == b) {  // last item: race against thieves for it
+                if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    item = nullptr;
+                _bottom.store(b + 1, std::memory_order_relaxed);
+            }
+        } else {
+            _bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    /**
+     * @brief Removes the oldest item; may be called from any thread.
+     *
+     * @return T* The item, or nullptr if the deque was empty or another thread won the race for the item.
+     */
+    T* steal() {
+        std::int64_t t = _top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t b = _bottom.load(std::memory_order_acquire);
+        if (t >= b)
+            return nullptr;
+        T* item = _array.load(std::memory_order_acquire)->get(t);
+        if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+        return item;
+    }
+
+private:
+    class Array {
+    public:
+        explicit Array(std::size_t size) : _items(size), _mask(size - 1) {}
+
+        std::size_t size() const {
+            return _items.size();
+        }
+
+        T* get(std::int64_t index) const {
+            return _items[index & _mask].load(std::memory_order_acquire);
+        }
+
+        void put(std::int64_t index, T* item) {
+            _items[index & _mask].store(item, std::memory_order_release);
+        }
+
+    private:
+        std::vector<std::atomic<T*>> _items;
+        std::size_t _mask;
+    };
+
+    Array* _grow(Array* old, std::int64_t top, std::int64_t bottom) {
+        _arrays.push_back(std::make_unique<Array>(2 * old->size()));
+        Array* array = _arrays.back().get();
+        for (std::int64_t i = top; i < bottom; ++i)
+            array->put(i, old->get(i));
+        _array.store(array, std::memory_order_release);
+        return array;
+    }
+
+    alignas(64) std::atomic<std::int64_t> _top{0};
+    alignas(64) std::atomic<std::int64_t> _bottom{0};
+    std::atomic<Array*> _array;
+    std::vector<std::unique_ptr<Array>> _arrays;  // owner only
+};
+
+/**
+ * @brief A unit of work that reports its completion to the group that spawned it.
+ */
+class Task {
+public:
+    virtual ~Task() = default;
+
+    /**
+     * @brief Runs the work of the task.
+     */
+    virtual void execute() = 0;
+
+    std::atomic<int>* pending = nullptr;  // counter of the spawning group
+};
+
+/**
+ * @brief A task that runs a callable.
+ *
+ * @tparam F The type of the callable.
+ */
+template <typename F>
+class FunctionTask : public Task {
+public:
+    explicit FunctionTask(F function) : _function(std::move(function)) {}
+
+    void execute() override {
+        _function();
+    }
+
+private:
+    F _function;
+};
+
+/**
+ * @brief Counters of one worker thread.
+ */
+struct WorkerStats {
+    std::uint64_t tasks_executed = 0;
+    std::uint64_t steals = 0;
+    double idle_seconds = 0;
+};
+
+class TaskGroup;
+
+/**
+ * @brief A pool of worker threads that execute tasks by work stealing.
+ */
+class Scheduler {
+public:
+    /**
+     * @brief Starts the worker threads.
+     *
+     * @param workers The number of worker threads; zero means one per hardware thread.
+     */
+    explicit Scheduler(unsigned workers = 0) {
+        if (workers == 0)
+            workers = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned i = 0; i < workers; ++i) {
+            _workers.push_back(std::make_unique<Worker>());
+            _workers.back()->scheduler = this;
+            _workers.back()->random = 0x9e3779b97f4a7c15ULL * (i + 1);
+        }
+        for (unsigned i = 0; i < workers; ++i)
+            _threads.emplace_back([this, i] { _worker_loop(*_workers[i]); });
+    }
+
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+
+    /**
+     * @brief Stops and joins the worker threads.
+     */
+    ~Scheduler() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _wake.notify_all();
+        for (std::thread& thread : _threads)
+            thread.join();
+    }
+
+    /**
+     * @brief Runs a callable on the workers and waits until it and every task it spawned have finished.
+     *
+     * @tparam F The type of the callable.
+     * @param function The root of the computation; it may use TaskGroup to spawn tasks.
+     */
+    template <typename F>
+    void run(F&& function) {
+        std::atomic<bool> done{false};
+        std::atomic<int> pending{1};
+        auto root = [&] {
+            function();
+            done.store(true, std::memory_order_release);
+            done.notify_one();
+        };
+        Task* task = new FunctionTask<decltype(root)>(root);
+        task->pending = &pending;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _injected.push_back(task);
+            ++_active_runs;
+        }
+        _wake.notify_all();
+        done.wait(false, std::memory_order_acquire);
+        while (pending.load(std::memory_order_acquire) != 0)  // the root task is released right after done is set
+            std::this_thread::yield();
+        std::lock_guard<std::mutex> lock(_mutex);
+        --_active_runs;
+    }
+
+    /**
+     * @brief Returns the number of worker threads.
+     *
+     * @return unsigned The number of workers.
+     */
+    unsigned worker_count() const {
+        return static_cast<unsigned>(_workers.size());
+    }
+
+    /**
+     * @brief Returns the counters of every worker.
+     *
+     * @return std::vector<WorkerStats> One entry per worker.
+     */
+    std::vector<WorkerStats> stats() const {
+        std::vector<WorkerStats> result;
+        for (const auto& worker : _workers) {
+            result.push_back({worker->tasks_executed.load(std::memory_order_relaxed),
+                              worker->steals.load(std::memory_order_relaxed),
+                              worker->idle_nanoseconds.load(std::memory_order_relaxed) * 1e-9});
+        }
+        return result;
+    }
+
+    /**
+     * @brief Resets the counters of every worker.
+     */
+    void reset_stats() {
+        for (const auto& worker : _workers) {
+            worker->tasks_executed.store(0, std::memory_order_relaxed);
+            worker->steals.store(0, std::memory_order_relaxed);
+            worker->idle_nanoseconds.store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    friend class TaskGroup;
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Worker {
+        ChaseLevDeque<Task> deque;
+        Scheduler* scheduler = nullptr;
+        std::uint64_t random = 0;
+        std::atomic<std::uint64_t> tasks_executed{0};
+        std::atomic<std::uint64_t> steals{0};
+        std::atomic<std::uint64_t> idle_nanoseconds{0};
+    };
+
+    /**
+     * @brief Accumulates idle time between failing to find work and finding it again.
+     */
+    class IdleTimer {
+    public:
+        explicit IdleTimer(Worker& worker) : _worker(worker) {}
+
+        ~IdleTimer() {
+            stop();
+        }
+
+        void start() {
+            if (!_idle) {
+                _idle = true;
+                _start = Clock::now();
+            }
+        }
+
+        void stop() {
+            if (_idle) {
+                _idle = false;
+                auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - _start).count();
+                _worker.idle_nanoseconds.fetch_add(elapsed, std::memory_order_relaxed);
+            }
+        }
+
+    private:
+        Worker& _worker;
+        bool _idle = false;
+        Clock::time_point _start;
+    };
+
+    static inline thread_local Worker* _current = nullptr;
+
+    /**
+     * @brief Finds a task: the newest local one, else one stolen from a random victim, else a root task.
+     */
+    Task* _find_task(Worker& worker) {
+        if (Task* task = worker.deque.take())
+            return task;
+
+        const std::size_t count = _workers.size();
+        worker.random ^= worker.random << 13;
+        worker.random ^= worker.random >> 7;
+        worker.random ^= worker.random << 17;
+        std::size_t start = worker.random % count;
+        for (std::size_t k = 0; k < count; ++k) {
+            Worker& victim = *_workers[(start + k) % count];
+            if (&victim == &worker)
+                continue;
+            if (Task* task = victim.deque.steal()) {
+                worker.steals.fetch_add(1, std::memory_order_relaxed);
+                return task;
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(_mutex, std::try_to_lock);
+        if (lock.owns_lock() && !_injected.empty()) {
+            Task* task = _injected.front();
+            _injected.pop_front();
+            return task;
+        }
+        return nullptr;
+    }
+
+    static void _execute(Worker& worker, Task* task) {
+        task->execute();
+        worker.tasks_executed.fetch_add(1, std::memory_order_relaxed);
+        std::atomic<int>* pending = task->pending;
+        delete task;
+        pending->fetch_sub(1, std::memory_order_release);
+    }
+
+    void _worker_loop(Worker& worker) {
+        _current = &worker;
+        IdleTimer idle(worker);
+        while (true) {
+            if (Task* task = _find_task(worker)) {
+                idle.stop();
+                _execute(worker, task);
+                continue;
+            }
+            idle.start();
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (_active_runs == 0 || _stopping) {  // nothing to do until the next run: sleep, uncounted
+                idle.stop();
+                _wake.wait(lock, [this] { return _active_runs != 0 || _stopping; });
+                if (_stopping)
+                    return;
+                continue;
+            }
+            lock.unlock();
+            std::this_thread::yield();
+        }
+    }
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::vector<std::thread> _threads;
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::deque<Task*> _injected;
+    int _active_runs = 0;
+    bool _stopping = false;
+};
+
+/**
+ * @brief A spawn/sync scope: tasks spawned through a group are all finished when sync() returns.
+ */
+class TaskGroup {
+public:
+    TaskGroup() = default;
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    /**
+     * @brief Waits for any task that was spawned but not synced.
+     */
+    ~TaskGroup() {
+        sync();
+    }
+
+    /**
+     * @brief Makes a callable available to other workers; outside a Scheduler it runs immediately.
+     *
+     * @tparam F The type of the callable.
+     * @param function The work to be spawned.
+     */
+    template <typename F>
+    void spawn(F&& function) {
+        Scheduler::Worker* worker = Scheduler::_current;
+        if (worker == nullptr) {
+            function();
+            return;
+        }
+        Task* task = new FunctionTask<std::decay_t<F>>(std::forward<F>(function));
+        task->pending = &_pending;
+        _pending.fetch_add(1, std::memory_order_relaxed);
+        worker->deque.push(task);
+    }
+
+    /**
+     * @brief Executes local or stolen tasks until every task spawned by this group has finished.
+     */
+    void sync() {
+        if (_pending.load(std::memory_order_acquire) == 0)
+            return;
+        Scheduler::Worker& worker = *Scheduler::_current;
+        Scheduler::IdleTimer idle(worker);
+        while (_pending.load(std::memory_order_acquire) != 0) {
+            if (Task* task = worker.scheduler->_find_task(worker)) {
+                idle.stop();
+                Scheduler::_execute(worker, task);
+            } else {
+                idle.start();
+                std::this_thread::yield();
+            }
+        }
+    }
+
+private:
+    std::atomic<int> _pending{0};
+};
+
+#endif // WORK_STEALING_H